@@ -7,28 +7,78 @@ Chorus::Chorus()
     : sampleRate_(SAMPLE_RATE)
     , mode_(OFF)
     , delayWritePos_(0)
+    , tailSamples_(0)
     , lfo1Phase_(0.0f)
     , lfo2Phase_(0.0f)
+    , lfo1Inc_(0.0f)
+    , lfo2Inc_(0.0f)
 {
-    std::memset(delayBuffer1_, 0, sizeof(delayBuffer1_));
-    std::memset(delayBuffer2_, 0, sizeof(delayBuffer2_));
+    std::memset(delayBuffer_, 0, sizeof(delayBuffer_));
+    updateCoefficients();
 }
 
 void Chorus::setSampleRate(float sampleRate) {
     sampleRate_ = sampleRate;
+    updateCoefficients();
     reset();
 }
 
 void Chorus::reset() {
-    std::memset(delayBuffer1_, 0, sizeof(delayBuffer1_));
-    std::memset(delayBuffer2_, 0, sizeof(delayBuffer2_));
+    std::memset(delayBuffer_, 0, sizeof(delayBuffer_));
     delayWritePos_ = 0;
+    tailSamples_ = 0;
     lfo1Phase_ = 0.0f;
     lfo2Phase_ = 0.0f;
 }
 
 void Chorus::setMode(Mode mode) {
+    if (mode == OFF && mode_ != OFF) {
+        // Nothing flushes the delay line while off: drop the tail now, so
+        // turning the chorus back on does not play stale audio
+        std::memset(delayBuffer_, 0, sizeof(delayBuffer_));
+        tailSamples_ = 0;
+    }
     mode_ = mode;
+    updateCoefficients();
+}
+
+void Chorus::updateCoefficients() {
+    // Delay times in samples
+    const float msToSamples = sampleRate_ / 1000.0f;
+    const float baseDelay1 = CHORUS_I_DELAY_MS * msToSamples;
+    const float depth1 = CHORUS_I_DEPTH_MS * msToSamples;
+    const float baseDelay2 = CHORUS_II_DELAY_MS * msToSamples;
+    const float depth2 = CHORUS_II_DEPTH_MS * msToSamples;
+
+    // Left and right channels use opposite LFO phases for stereo width
+    tapOffset_[0] = DELAY_BUFFER_SIZE - baseDelay1;
+    tapOffset_[1] = DELAY_BUFFER_SIZE - baseDelay1;
+    tapOffset_[2] = DELAY_BUFFER_SIZE - baseDelay2;
+    tapOffset_[3] = DELAY_BUFFER_SIZE - baseDelay2;
+    tapDepth_[0] = depth1;
+    tapDepth_[1] = -depth1;
+    tapDepth_[2] = depth2;
+    tapDepth_[3] = -depth2;
+
+    // Juno-106 chorus has a subtle mix (approximately 80% dry, 20% wet per stage).
+    // When both are active, reduce wet level slightly to prevent buildup
+    float wet1 = 0.0f;
+    float wet2 = 0.0f;
+    if (mode_ == MODE_I) {
+        wet1 = 0.2f;
+    } else if (mode_ == MODE_II) {
+        wet2 = 0.2f;
+    } else if (mode_ == MODE_BOTH) {
+        wet1 = 0.15f;
+        wet2 = 0.15f;
+    }
+    tapWet_[0] = wet1;
+    tapWet_[1] = wet1;
+    tapWet_[2] = wet2;
+    tapWet_[3] = wet2;
+
+    lfo1Inc_ = CHORUS_I_RATE_HZ / sampleRate_;
+    lfo2Inc_ = CHORUS_II_RATE_HZ / sampleRate_;
 }
 
 float Chorus::getLfoValue(float phase) const {
@@ -41,109 +91,99 @@ float Chorus::getLfoValue(float phase) const {
     }
 }
 
-Sample Chorus::readDelayLine(const Sample* buffer, float delaySamples) const {
-    // Linear interpolation for smooth delay modulation
-    float readPos = delayWritePos_ - delaySamples;
+bool Chorus::advanceTail(const Sample* input, int numSamples) {
+    bool silent = true;
+    for (int i = 0; i < numSamples; ++i) {
+        if (input[i] != 0.0f) {
+            silent = false;
+            break;
+        }
+    }
 
-    // Wrap around buffer
-    while (readPos < 0.0f) {
-        readPos += MAX_DELAY_SAMPLES;
+    if (!silent) {
+        // The last non-zero sample leaves the delay line after a full buffer
+        tailSamples_ = DELAY_BUFFER_SIZE;
+        return false;
     }
-    while (readPos >= MAX_DELAY_SAMPLES) {
-        readPos -= MAX_DELAY_SAMPLES;
+    if (tailSamples_ <= 0) {
+        return true;  // Delay line is all zeros - nothing to render
     }
-
-    // Get integer and fractional parts
-    int index0 = static_cast<int>(readPos);
-    int index1 = (index0 + 1) % MAX_DELAY_SAMPLES;
-    float frac = readPos - index0;
-
-    // Linear interpolation
-    return buffer[index0] + frac * (buffer[index1] - buffer[index0]);
+    tailSamples_ -= numSamples;
+    return false;
 }
 
 void Chorus::process(Sample input, Sample& leftOut, Sample& rightOut) {
-    // If chorus is off, just pass through dry signal
+    process(&input, &leftOut, &rightOut, 1);
+}
+
+void Chorus::process(const Sample* input, Sample* leftOutput, Sample* rightOutput, int numSamples) {
+    // If chorus is off, just copy the dry signal to both channels
     if (mode_ == OFF) {
-        leftOut = input;
-        rightOut = input;
+        std::memcpy(leftOutput, input, sizeof(Sample) * numSamples);
+        std::memcpy(rightOutput, input, sizeof(Sample) * numSamples);
         return;
     }
 
-    // Write input to both delay lines
-    delayBuffer1_[delayWritePos_] = input;
-    delayBuffer2_[delayWritePos_] = input;
-
-    // Update write position
-    delayWritePos_ = (delayWritePos_ + 1) % MAX_DELAY_SAMPLES;
-
-    // Process Chorus I (if enabled)
-    Sample chorus1Left = 0.0f;
-    Sample chorus1Right = 0.0f;
-
-    if (mode_ == MODE_I || mode_ == MODE_BOTH) {
-        // Update LFO1
-        float lfo1 = getLfoValue(lfo1Phase_);
-        lfo1Phase_ += CHORUS_I_RATE_HZ / sampleRate_;
-        if (lfo1Phase_ >= 1.0f) {
-            lfo1Phase_ -= 1.0f;
-        }
-
-        // Calculate modulated delay time in samples
-        float baseDelay1 = CHORUS_I_DELAY_MS * sampleRate_ / 1000.0f;
-        float depthSamples1 = CHORUS_I_DEPTH_MS * sampleRate_ / 1000.0f;
-
-        // Left and right channels use opposite LFO phases for stereo width
-        float delayLeft1 = baseDelay1 + lfo1 * depthSamples1;
-        float delayRight1 = baseDelay1 - lfo1 * depthSamples1;
+    // Silent input and a flushed delay line: output silence, keep the LFOs moving
+    if (advanceTail(input, numSamples)) {
+        std::memset(leftOutput, 0, sizeof(Sample) * numSamples);
+        std::memset(rightOutput, 0, sizeof(Sample) * numSamples);
+        lfo1Phase_ += lfo1Inc_ * numSamples;
+        lfo2Phase_ += lfo2Inc_ * numSamples;
+        lfo1Phase_ -= std::floor(lfo1Phase_);
+        lfo2Phase_ -= std::floor(lfo2Phase_);
+        return;
+    }
 
-        // Read from delay line with modulated delays
-        chorus1Left = readDelayLine(delayBuffer1_, delayLeft1);
-        chorus1Right = readDelayLine(delayBuffer1_, delayRight1);
+    if (mode_ == MODE_I) {
+        processTaps<0, 2>(input, leftOutput, rightOutput, numSamples);
+    } else if (mode_ == MODE_II) {
+        processTaps<2, 2>(input, leftOutput, rightOutput, numSamples);
+    } else {
+        processTaps<0, 4>(input, leftOutput, rightOutput, numSamples);
     }
+}
 
-    // Process Chorus II (if enabled)
-    Sample chorus2Left = 0.0f;
-    Sample chorus2Right = 0.0f;
+template <int FirstTap, int NumTaps>
+void Chorus::processTaps(const Sample* input, Sample* leftOutput, Sample* rightOutput, int numSamples) {
+    constexpr float dryLevel = 0.8f;
 
-    if (mode_ == MODE_II || mode_ == MODE_BOTH) {
-        // Update LFO2 (offset by 90 degrees from LFO1 for richer sound)
+    for (int i = 0; i < numSamples; ++i) {
+        // Write input to the delay line
+        delayBuffer_[delayWritePos_] = input[i];
+        delayWritePos_ = (delayWritePos_ + 1) & DELAY_BUFFER_MASK;
+
+        // Update LFOs (both run in every mode, so switching modes keeps phase)
+        float lfo1 = getLfoValue(lfo1Phase_);
         float lfo2 = getLfoValue(lfo2Phase_);
-        lfo2Phase_ += CHORUS_II_RATE_HZ / sampleRate_;
-        if (lfo2Phase_ >= 1.0f) {
-            lfo2Phase_ -= 1.0f;
+        lfo1Phase_ += lfo1Inc_;
+        lfo2Phase_ += lfo2Inc_;
+        if (lfo1Phase_ >= 1.0f) lfo1Phase_ -= 1.0f;
+        if (lfo2Phase_ >= 1.0f) lfo2Phase_ -= 1.0f;
+
+        // Read the taps with modulated delays (linear interpolation).
+        // Offsets are positive, so the read position only needs a mask
+        const float lfo[NUM_TAPS] = { lfo1, lfo1, lfo2, lfo2 };
+        const float writePos = static_cast<float>(delayWritePos_);
+        float tap[NUM_TAPS];
+        for (int t = FirstTap; t < FirstTap + NumTaps; ++t) {
+            float readPos = writePos + tapOffset_[t] - lfo[t] * tapDepth_[t];
+            int index = static_cast<int>(readPos);
+            float frac = readPos - static_cast<float>(index);
+            Sample s0 = delayBuffer_[index & DELAY_BUFFER_MASK];
+            Sample s1 = delayBuffer_[(index + 1) & DELAY_BUFFER_MASK];
+            tap[t] = tapWet_[t] * (s0 + frac * (s1 - s0));
         }
 
-        // Calculate modulated delay time in samples
-        float baseDelay2 = CHORUS_II_DELAY_MS * sampleRate_ / 1000.0f;
-        float depthSamples2 = CHORUS_II_DEPTH_MS * sampleRate_ / 1000.0f;
-
-        // Left and right channels use opposite LFO phases
-        float delayLeft2 = baseDelay2 + lfo2 * depthSamples2;
-        float delayRight2 = baseDelay2 - lfo2 * depthSamples2;
-
-        // Read from delay line with modulated delays
-        chorus2Left = readDelayLine(delayBuffer2_, delayLeft2);
-        chorus2Right = readDelayLine(delayBuffer2_, delayRight2);
-    }
-
-    // Mix dry and wet signals
-    // Juno-106 chorus has a subtle mix (approximately 80% dry, 20% wet per stage)
-    constexpr float dryLevel = 0.8f;
-    constexpr float wetLevel = 0.2f;
-
-    if (mode_ == MODE_I) {
-        leftOut = dryLevel * input + wetLevel * chorus1Left;
-        rightOut = dryLevel * input + wetLevel * chorus1Right;
-    } else if (mode_ == MODE_II) {
-        leftOut = dryLevel * input + wetLevel * chorus2Left;
-        rightOut = dryLevel * input + wetLevel * chorus2Right;
-    } else if (mode_ == MODE_BOTH) {
-        // When both are active, mix all signals
-        // Reduce wet level slightly to prevent buildup
-        constexpr float bothWetLevel = 0.15f;
-        leftOut = dryLevel * input + bothWetLevel * (chorus1Left + chorus2Left);
-        rightOut = dryLevel * input + bothWetLevel * (chorus1Right + chorus2Right);
+        // Mix dry and wet signals (even taps left, odd taps right)
+        Sample left = dryLevel * input[i];
+        Sample right = left;
+        for (int t = FirstTap; t < FirstTap + NumTaps; t += 2) {
+            left += tap[t];
+            right += tap[t + 1];
+        }
+        leftOutput[i] = left;
+        rightOutput[i] = right;
     }
 }
 
@@ -17,6 +17,12 @@ namespace phj {
  * - Stereo output with different modulation per channel
  * - Three modes: I, II, and I+II (both)
  *
+ * Both stages read the same delay line (the BBDs share one input). The
+ * line is a power-of-two ring buffer wrapped with a mask, and the delay
+ * and LFO constants for the current mode are precomputed in
+ * setSampleRate/setMode. Once the input has been silent for longer than
+ * the delay line, blocks of silence are skipped.
+ *
  * M8: BBD Chorus Implementation
  */
 class Chorus {
@@ -29,6 +35,9 @@ public:
     // Process stereo (input is mono, outputs are stereo)
     void process(Sample input, Sample& leftOut, Sample& rightOut);
 
+    // Process buffer (input is mono, outputs are stereo)
+    void process(const Sample* input, Sample* leftOutput, Sample* rightOutput, int numSamples);
+
     // Chorus modes (matching Juno-106)
     enum Mode {
         OFF = 0,     // No chorus
@@ -40,16 +49,21 @@ public:
     void setMode(Mode mode);
     Mode getMode() const { return mode_; }
 
+    // True when the output is silent for silent input (delay line flushed;
+    // switching to OFF clears it)
+    bool isIdle() const { return tailSamples_ <= 0; }
+
 private:
     float sampleRate_;
     Mode mode_;
 
-    // BBD delay lines for each stage
-    // Maximum delay: ~10ms at 48kHz = 480 samples
-    static constexpr int MAX_DELAY_SAMPLES = 512;
-    Sample delayBuffer1_[MAX_DELAY_SAMPLES];
-    Sample delayBuffer2_[MAX_DELAY_SAMPLES];
+    // BBD delay line (shared by both stages), power-of-two ring buffer
+    // Longest tap: 4.8ms = 922 samples at 192kHz
+    static constexpr int DELAY_BUFFER_SIZE = 1024;
+    static constexpr int DELAY_BUFFER_MASK = DELAY_BUFFER_SIZE - 1;
+    Sample delayBuffer_[DELAY_BUFFER_SIZE];
     int delayWritePos_;
+    int tailSamples_;        // Samples until the delay line holds only silence
 
     // LFO state for each BBD stage
     float lfo1Phase_;
@@ -66,8 +80,22 @@ private:
     static constexpr float CHORUS_II_DEPTH_MS = 0.8f;
     static constexpr float CHORUS_II_RATE_HZ = 0.50f;
 
+    // Precomputed per sample rate / mode (see updateCoefficients)
+    // Taps are ordered I left, I right, II left, II right
+    static constexpr int NUM_TAPS = 4;
+    float tapOffset_[NUM_TAPS];  // DELAY_BUFFER_SIZE - base delay, in samples
+    float tapDepth_[NUM_TAPS];   // Signed modulation depth in samples
+    float tapWet_[NUM_TAPS];     // Wet level (0 for stages not in the mode)
+    float lfo1Inc_;
+    float lfo2Inc_;
+
     // Helper functions
-    Sample readDelayLine(const Sample* buffer, float delaySamples) const;
+    void updateCoefficients();
+    bool advanceTail(const Sample* input, int numSamples);
+
+    // Block loop over taps [FirstTap, FirstTap + NumTaps) (one or both stages)
+    template <int FirstTap, int NumTaps>
+    void processTaps(const Sample* input, Sample* leftOutput, Sample* rightOutput, int numSamples);
     float getLfoValue(float phase) const;
 };
 
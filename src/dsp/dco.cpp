@@ -6,18 +6,23 @@ namespace phj {
 Dco::Dco()
     : sampleRate_(SAMPLE_RATE)
     , baseFrequency_(440.0f)
-    , currentFrequency_(440.0f)
     , mainPhase_(0.0f)
     , subPhase_(0.0f)
     , mainPhaseInc_(0.0f)
     , subPhaseInc_(0.0f)
+    , staticPhaseInc_(0.0f)
+    , staticScale_(0.0f)
+    , driftPhaseInc_(0.0f)
+    , driftPhaseIncStep_(0.0f)
     , lfoValue_(0.0f)
+    , lfoPitchRatio_(1.0f)
     , driftAmount_(0.0f)
     , driftTarget_(0.0f)
     , driftCounter_(0)
-    , rng_(std::random_device{}())
-    , noiseDist_(-1.0f, 1.0f)
-    , driftDist_(0.0f, 0.5f)  // ±0.5 cents standard deviation
+    , driftTimer_(0)
+    // Per-sample smoothing applied DRIFT_CONTROL_INTERVAL times in one step
+    , driftTickAlpha_(1.0f - std::pow(1.0f - DRIFT_ALPHA, static_cast<float>(DRIFT_CONTROL_INTERVAL)))
+    , rng_()
 {
     updatePhaseIncrements();
 }
@@ -29,28 +34,56 @@ void Dco::setSampleRate(float sampleRate) {
 
 void Dco::setFrequency(float frequency) {
     baseFrequency_ = frequency;
-    updatePhaseIncrements();
+    if (staticPhaseInc_ <= 0.0f) {
+        updatePhaseIncrements();
+        return;
+    }
+
+    // Rescale the current drift ramp instead of restarting it, so the drift
+    // control ticks keep their interval while the pitch glides
+    const float staticPhaseInc = frequency * staticScale_;
+    const float ratio = staticPhaseInc / staticPhaseInc_;
+    staticPhaseInc_ = staticPhaseInc;
+    driftPhaseInc_ *= ratio;
+    driftPhaseIncStep_ *= ratio;
+    applyPhaseIncrements();
 }
 
 void Dco::setParameters(const DcoParams& params) {
     params_ = params;
-    // No need to update phase increments here unless frequency changed
+    // Range, detune, drift and LFO routing all feed the increments
+    updateLfoPitchRatio();
+    updatePhaseIncrements();
 }
 
 void Dco::setLfoValue(float lfoValue) {
-    lfoValue_ = clamp(lfoValue, -1.0f, 1.0f);
+    lfoValue = clamp(lfoValue, -1.0f, 1.0f);
+    if (lfoValue == lfoValue_) {
+        return;
+    }
+    lfoValue_ = lfoValue;
+
+    if (params_.lfoTarget == DcoParams::LFO_PITCH ||
+        params_.lfoTarget == DcoParams::LFO_BOTH) {
+        updateLfoPitchRatio();
+        applyPhaseIncrements();
+    }
+}
+
+void Dco::setSeed(uint64_t seed, uint64_t stream) {
+    rng_.setSeed(seed, stream);
 }
 
 void Dco::noteOn() {
     // Random phase on note-on (Juno characteristic)
-    std::uniform_real_distribution<float> phaseDist(0.0f, 1.0f);
-    mainPhase_ = phaseDist(rng_);
-    subPhase_ = phaseDist(rng_);
+    mainPhase_ = rng_.nextFloat();
+    subPhase_ = rng_.nextFloat();
 
     // Reset drift
     driftAmount_ = 0.0f;
-    driftTarget_ = params_.enableDrift ? driftDist_(rng_) : 0.0f;
-    driftCounter_ = 0;
+    driftTarget_ = params_.enableDrift ? rng_.nextGaussian() * DRIFT_DEVIATION : 0.0f;
+    driftTimer_ = 0;
+    updatePhaseIncrements();
 }
 
 void Dco::noteOff() {
@@ -62,17 +95,18 @@ void Dco::reset() {
     subPhase_ = 0.0f;
     driftAmount_ = 0.0f;
     driftTarget_ = 0.0f;
-    driftCounter_ = 0;
+    driftTimer_ = 0;
+    updatePhaseIncrements();
 }
 
 Sample Dco::process() {
-    // Update pitch drift and phase increments
-    updateDrift();
+    return process(params_.noiseLevel > 0.0f ? generateNoise() : 0.0f);
+}
 
-    // Always update phase increments to apply LFO modulation
-    // (updateDrift only calls this if drift is enabled)
-    if (!params_.enableDrift) {
-        updatePhaseIncrements();
+Sample Dco::process(Sample noise) {
+    // Pitch drift (LFO pitch is applied when the LFO value changes)
+    if (params_.enableDrift) {
+        updateDrift();
     }
 
     // Calculate current pulse width (with LFO modulation if enabled)
@@ -88,10 +122,9 @@ Sample Dco::process() {
     Sample saw = params_.sawLevel * generateSaw(mainPhase_, mainPhaseInc_);
     Sample pulse = params_.pulseLevel * generatePulse(mainPhase_, mainPhaseInc_, pulseWidth);
     Sample sub = params_.subLevel * generateSub(subPhase_);
-    Sample noise = params_.noiseLevel * generateNoise();
 
     // Mix waveforms
-    Sample output = saw + pulse + sub + noise;
+    Sample output = saw + pulse + sub + params_.noiseLevel * noise;
 
     // Advance phases
     mainPhase_ += mainPhaseInc_;
@@ -125,44 +158,61 @@ void Dco::updatePhaseIncrements() {
             break;
     }
 
-    // Calculate total frequency with detune, drift, and LFO
-    float detuneFactor = std::pow(2.0f, params_.detune / 1200.0f);
-    float driftFactor = std::pow(2.0f, driftAmount_ / 1200.0f);
+    // Static part: frequency with range and detune
+    float detuneFactor = centsToRatio(params_.detune);
+    staticScale_ = rangeFactor * detuneFactor / sampleRate_;
+    staticPhaseInc_ = baseFrequency_ * staticScale_;
 
-    float pitchMod = 1.0f;
-    if (params_.lfoTarget == DcoParams::LFO_PITCH ||
-        params_.lfoTarget == DcoParams::LFO_BOTH) {
-        // LFO pitch modulation: ±1 semitone range typical
-        pitchMod = std::pow(2.0f, lfoValue_ / 12.0f);
+    if (!params_.enableDrift) {
+        driftAmount_ = 0.0f;
     }
 
-    currentFrequency_ = baseFrequency_ * rangeFactor * detuneFactor * driftFactor * pitchMod;
+    // Jump to the current drift (no ramp); the next control tick ramps from here
+    driftPhaseInc_ = staticPhaseInc_ * centsToRatio(driftAmount_);
+    driftPhaseIncStep_ = 0.0f;
+    driftCounter_ = 0;
 
-    // Calculate phase increments
-    mainPhaseInc_ = currentFrequency_ / sampleRate_;
-    subPhaseInc_ = (currentFrequency_ * 0.5f) / sampleRate_; // -1 octave = half frequency
+    applyPhaseIncrements();
 }
 
-void Dco::updateDrift() {
-    if (!params_.enableDrift) {
-        driftAmount_ = 0.0f;
-        return;
+void Dco::updateLfoPitchRatio() {
+    lfoPitchRatio_ = 1.0f;
+    if (params_.lfoTarget == DcoParams::LFO_PITCH ||
+        params_.lfoTarget == DcoParams::LFO_BOTH) {
+        // LFO pitch modulation: ±1 semitone range typical
+        lfoPitchRatio_ = semitonesToRatio(lfoValue_);
     }
+}
 
-    driftCounter_++;
+void Dco::applyPhaseIncrements() {
+    mainPhaseInc_ = driftPhaseInc_ * lfoPitchRatio_;
+    subPhaseInc_ = mainPhaseInc_ * 0.5f;  // -1 octave = half frequency
+}
 
-    // Update drift target every ~100ms
-    if (driftCounter_ >= DRIFT_UPDATE_SAMPLES) {
-        driftTarget_ = driftDist_(rng_);
-        driftCounter_ = 0;
+void Dco::updateDrift() {
+    // Control tick: advance the drift by a whole interval and ramp the phase
+    // increment towards the new value over the next interval
+    if (driftCounter_ <= 0) {
+        driftTimer_ += DRIFT_CONTROL_INTERVAL;
+
+        // Update drift target every ~100ms
+        if (driftTimer_ >= DRIFT_UPDATE_SAMPLES) {
+            driftTarget_ = rng_.nextGaussian() * DRIFT_DEVIATION;
+            driftTimer_ -= DRIFT_UPDATE_SAMPLES;
+        }
+
+        // Smoothly move towards target (one-pole low-pass, per tick)
+        driftAmount_ += driftTickAlpha_ * (driftTarget_ - driftAmount_);
+
+        float target = staticPhaseInc_ * centsToRatio(driftAmount_);
+        driftPhaseIncStep_ = (target - driftPhaseInc_) / static_cast<float>(DRIFT_CONTROL_INTERVAL);
+        driftCounter_ = DRIFT_CONTROL_INTERVAL;
     }
 
-    // Smoothly move towards target (simple low-pass filter)
-    float alpha = 0.0001f; // Very slow drift
-    driftAmount_ += alpha * (driftTarget_ - driftAmount_);
+    driftPhaseInc_ += driftPhaseIncStep_;
+    --driftCounter_;
 
-    // Update phase increments with new drift
-    updatePhaseIncrements();
+    applyPhaseIncrements();
 }
 
 Sample Dco::generateSaw(float phase, float phaseInc) {
@@ -193,8 +243,8 @@ Sample Dco::generateSub(float phase) {
 }
 
 Sample Dco::generateNoise() {
-    // White noise
-    return noiseDist_(rng_);
+    // White noise, uniform in [-1, 1)
+    return rng_.nextBipolar();
 }
 
 float Dco::polyBlep(float t, float dt) {
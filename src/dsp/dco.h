@@ -2,7 +2,8 @@
 
 #include "types.h"
 #include "parameters.h"
-#include <random>
+#include "random.h"
+#include <cstdint>
 
 namespace phj {
 
@@ -16,6 +17,13 @@ namespace phj {
  * - White noise generator
  * - Pitch drift emulation
  * - Per-voice detuning
+ *
+ * Pitch drift runs at control rate (every DRIFT_CONTROL_INTERVAL samples)
+ * and the phase increment ramps linearly between control ticks. Without
+ * drift or LFO pitch modulation the increments are only recomputed when
+ * the frequency or parameters change. A frequency change (e.g. every sample
+ * during portamento) rescales the increments and keeps the drift ticking on
+ * its own schedule.
  */
 class Dco {
 public:
@@ -26,13 +34,21 @@ public:
     void setParameters(const DcoParams& params);
     void setLfoValue(float lfoValue);  // -1.0 to 1.0
 
+    // Seed the noise/drift/phase generator (stream selects an independent
+    // sequence for the same seed, e.g. one per voice)
+    void setSeed(uint64_t seed, uint64_t stream = 0);
+
     void noteOn();
     void noteOff();
     void reset();
 
-    // Process single sample
+    // Process single sample (noise from this DCO's own generator)
     Sample process();
 
+    // Process single sample with an external white noise sample in [-1, 1]
+    // (the Synth's shared noise source), scaled by noiseLevel
+    Sample process(Sample noise);
+
     // Process buffer
     void process(Sample* output, int numSamples);
 
@@ -40,7 +56,6 @@ private:
     // Oscillator state
     float sampleRate_;
     float baseFrequency_;    // Base frequency without modulation
-    float currentFrequency_; // Current frequency with drift/detune
     DcoParams params_;
 
     // Phase accumulators
@@ -50,24 +65,34 @@ private:
     // Phase increments
     float mainPhaseInc_;
     float subPhaseInc_;
+    float staticPhaseInc_;   // Base frequency with range and detune (no drift/LFO)
+    float staticScale_;      // Range x detune / sample rate (staticPhaseInc_ per Hz)
+    float driftPhaseInc_;    // staticPhaseInc_ with drift, ramped between ticks
+    float driftPhaseIncStep_;
 
     // LFO modulation
     float lfoValue_;
+    float lfoPitchRatio_;    // Cached LFO pitch ratio (1.0 when not routed)
 
     // Pitch drift state
     float driftAmount_;      // Current drift amount in cents
     float driftTarget_;      // Target drift amount
-    int driftCounter_;       // Sample counter for drift updates
+    int driftCounter_;       // Samples until the next drift control tick
+    int driftTimer_;         // Samples since the last drift target change
+    float driftTickAlpha_;   // Smoothing coefficient per control tick
     static constexpr int DRIFT_UPDATE_SAMPLES = 4800; // ~100ms at 48kHz
+    static constexpr int DRIFT_CONTROL_INTERVAL = 32; // Samples per drift update
+    static constexpr float DRIFT_ALPHA = 0.0001f;     // Per-sample smoothing (very slow)
 
-    // Random number generator (for noise and drift)
-    std::mt19937 rng_;
-    std::uniform_real_distribution<float> noiseDist_;
-    std::normal_distribution<float> driftDist_;
+    // Random number generator (for noise, drift and note-on phase)
+    Random rng_;
+    static constexpr float DRIFT_DEVIATION = 0.5f;  // Standard deviation in cents
 
     // Internal methods
-    void updatePhaseIncrements();
-    void updateDrift();
+    void updatePhaseIncrements();   // Full recompute (frequency/parameter changes)
+    void updateLfoPitchRatio();
+    void applyPhaseIncrements();    // Drift increment x LFO ratio
+    void updateDrift();             // Per-sample drift ramp, control tick every interval
 
     // Waveform generators (with polyBLEP anti-aliasing)
     Sample generateSaw(float phase, float phaseInc);
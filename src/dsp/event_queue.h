@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace phj {
+
+/**
+ * MidiEvent - One timestamped channel message
+ *
+ * status holds the full status byte (type and channel); data1/data2 are
+ * unused for messages that carry fewer data bytes. The timestamp is in the
+ * producer's clock (nanoseconds, CLOCK_MONOTONIC on the Pi).
+ */
+struct MidiEvent {
+    uint64_t timestamp;
+    uint8_t status;
+    uint8_t data1;
+    uint8_t data2;
+};
+
+/**
+ * SpscQueue - Wait-free single-producer/single-consumer ring buffer
+ *
+ * Carries events from one thread (e.g. the MIDI thread) to another (the
+ * audio thread) without locks or allocation: push() is only ever called by
+ * the producer and pop() only by the consumer. Both return false instead of
+ * blocking when the queue is full/empty.
+ *
+ * Capacity must be a power of two; indices run freely and are wrapped with
+ * a mask, so all Capacity slots are usable.
+ */
+template <typename T, int Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscQueue capacity must be a power of two");
+
+public:
+    SpscQueue() : head_(0), tail_(0) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer side
+    bool push(const T& item) {
+        const uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) >= static_cast<uint32_t>(Capacity)) {
+            return false;  // Full
+        }
+        items_[tail & MASK] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool pop(T& item) {
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;  // Empty
+        }
+        item = items_[head & MASK];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: oldest item without removing it (nullptr when empty)
+    const T* peek() const {
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &items_[head & MASK];
+    }
+
+    // Either side (a snapshot; may be stale by the time it is used)
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    static constexpr int capacity() { return Capacity; }
+
+private:
+    static constexpr uint32_t MASK = static_cast<uint32_t>(Capacity) - 1;
+
+    // Consumer and producer indices on separate cache lines (no false sharing)
+    alignas(64) std::atomic<uint32_t> head_;
+    alignas(64) std::atomic<uint32_t> tail_;
+    alignas(64) T items_[Capacity];
+};
+
+} // namespace phj
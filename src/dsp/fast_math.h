@@ -0,0 +1,194 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace phj {
+
+/**
+ * Fast math kernels for the DSP core
+ *
+ * Table-driven replacements for the std::pow(2, x) and std::tan calls in the
+ * pitch and cutoff mapping paths. The tables are generated at compile time
+ * (constexpr), so there is no runtime initialization.
+ *
+ * Accuracy (measured in tests/test_fast_math.cpp against double precision):
+ * - fastExp2: max relative error 2e-7 over [-126, 127]
+ * - fastTan:  max relative error 2e-6 over [0, 0.49 * pi]
+ *             (the filter's full range: pi * fc / fs with fc <= 0.49 * fs)
+ */
+namespace fastmath {
+
+// ----------------------------------------------------------------------------
+// Compile-time helpers (double precision, only used to build the tables)
+// ----------------------------------------------------------------------------
+
+constexpr double PI_D = 3.14159265358979323846;
+constexpr double LN2_D = 0.69314718055994530942;
+
+// exp(x) by Taylor series, accurate for |x| <= 1
+constexpr double constexprExp(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int n = 1; n < 25; ++n) {
+        term *= x / n;
+        sum += term;
+    }
+    return sum;
+}
+
+// log2(x) for x > 0: reduce to [1, 2), then ln by the atanh series
+constexpr double constexprLog2(double x) {
+    int octaves = 0;
+    while (x >= 2.0) { x /= 2.0; ++octaves; }
+    while (x < 1.0) { x *= 2.0; --octaves; }
+    const double y = (x - 1.0) / (x + 1.0);  // <= 1/3
+    double sum = 0.0;
+    double term = y;
+    for (int n = 1; n < 40; n += 2) {
+        sum += term / n;
+        term *= y * y;
+    }
+    return octaves + 2.0 * sum / LN2_D;
+}
+
+// sin(x) and cos(x) by Taylor series, accurate for |x| <= pi/4
+constexpr double constexprSin(double x) {
+    double sum = x;
+    double term = x;
+    for (int n = 1; n < 15; ++n) {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double constexprCos(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int n = 1; n < 15; ++n) {
+        term *= -x * x / ((2 * n - 1) * (2 * n));
+        sum += term;
+    }
+    return sum;
+}
+
+// ----------------------------------------------------------------------------
+// exp2: 2^x = 2^i * 2^(j/64) * 2^r, i integer, j table index, r in [0, 1/64)
+// ----------------------------------------------------------------------------
+
+constexpr int EXP2_TABLE_BITS = 6;
+constexpr int EXP2_TABLE_SIZE = 1 << EXP2_TABLE_BITS;
+
+constexpr std::array<float, EXP2_TABLE_SIZE> makeExp2Table() {
+    std::array<float, EXP2_TABLE_SIZE> table{};
+    for (int j = 0; j < EXP2_TABLE_SIZE; ++j) {
+        table[j] = static_cast<float>(constexprExp(LN2_D * j / EXP2_TABLE_SIZE));
+    }
+    return table;
+}
+
+constexpr std::array<float, EXP2_TABLE_SIZE> EXP2_TABLE = makeExp2Table();
+
+// 2^r for r in [0, 1/64): cubic Taylor polynomial of exp(r * ln2)
+constexpr float EXP2_C1 = static_cast<float>(LN2_D);
+constexpr float EXP2_C2 = static_cast<float>(LN2_D * LN2_D / 2.0);
+constexpr float EXP2_C3 = static_cast<float>(LN2_D * LN2_D * LN2_D / 6.0);
+
+// ----------------------------------------------------------------------------
+// tan: cubic Hermite table on [0, pi/4] (derivative = 1 + tan^2),
+// tan(x) = 1 / tan(pi/2 - x) above pi/4
+// ----------------------------------------------------------------------------
+
+constexpr int TAN_TABLE_SIZE = 64;
+constexpr double TAN_TABLE_STEP = (PI_D / 4.0) / TAN_TABLE_SIZE;
+
+constexpr std::array<float, TAN_TABLE_SIZE + 1> makeTanTable() {
+    std::array<float, TAN_TABLE_SIZE + 1> table{};
+    for (int j = 0; j <= TAN_TABLE_SIZE; ++j) {
+        double x = j * TAN_TABLE_STEP;
+        table[j] = static_cast<float>(constexprSin(x) / constexprCos(x));
+    }
+    return table;
+}
+
+constexpr std::array<float, TAN_TABLE_SIZE + 1> TAN_TABLE = makeTanTable();
+
+constexpr float PI_OVER_2 = static_cast<float>(PI_D / 2.0);
+constexpr float PI_OVER_4 = static_cast<float>(PI_D / 4.0);
+constexpr float TAN_INV_STEP = static_cast<float>(1.0 / TAN_TABLE_STEP);
+constexpr float TAN_STEP = static_cast<float>(TAN_TABLE_STEP);
+
+// tan(x) for x in [0, pi/4]
+inline float tanQuadrant(float x) {
+    float pos = x * TAN_INV_STEP;
+    int index = static_cast<int>(pos);
+    if (index >= TAN_TABLE_SIZE) index = TAN_TABLE_SIZE - 1;
+    float t = pos - static_cast<float>(index);
+
+    float y0 = TAN_TABLE[index];
+    float y1 = TAN_TABLE[index + 1];
+    float d0 = (1.0f + y0 * y0) * TAN_STEP;  // Slopes scaled to one table step
+    float d1 = (1.0f + y1 * y1) * TAN_STEP;
+
+    // Cubic Hermite basis
+    float t2 = t * t;
+    float t3 = t2 * t;
+    return y0 * (2.0f * t3 - 3.0f * t2 + 1.0f)
+         + d0 * (t3 - 2.0f * t2 + t)
+         + y1 * (-2.0f * t3 + 3.0f * t2)
+         + d1 * (t3 - t2);
+}
+
+} // namespace fastmath
+
+/**
+ * 2^x. Inputs are clamped to [-126, 127] (normal float range).
+ */
+inline float fastExp2(float x) {
+    if (x < -126.0f) x = -126.0f;
+    if (x > 127.0f) x = 127.0f;
+
+    // Split into integer octave and table position. The offset keeps the
+    // value positive so truncation is a floor (x >= -126 -> scaled >= -8064)
+    float scaled = x * static_cast<float>(fastmath::EXP2_TABLE_SIZE);
+    int32_t fixedPos = static_cast<int32_t>(scaled + 8192.0f) - 8192;
+
+    float r = (scaled - static_cast<float>(fixedPos)) * (1.0f / fastmath::EXP2_TABLE_SIZE);
+    int32_t octave = fixedPos >> fastmath::EXP2_TABLE_BITS;  // Arithmetic shift = floor
+    int32_t index = fixedPos & (fastmath::EXP2_TABLE_SIZE - 1);
+
+    float poly = 1.0f + r * (fastmath::EXP2_C1 + r * (fastmath::EXP2_C2 + r * fastmath::EXP2_C3));
+    float mantissa = fastmath::EXP2_TABLE[index] * poly;
+
+    // Scale by 2^octave through the exponent bits
+    int32_t bits = (octave + 127) << 23;
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return mantissa * scale;
+}
+
+/**
+ * tan(x) for x in [0, pi/2). Used for bilinear-transform prewarping.
+ */
+inline float fastTan(float x) {
+    if (x <= 0.0f) return 0.0f;
+    if (x <= fastmath::PI_OVER_4) {
+        return fastmath::tanQuadrant(x);
+    }
+    float complement = fastmath::PI_OVER_2 - x;
+    if (complement < 1e-6f) complement = 1e-6f;
+    return 1.0f / fastmath::tanQuadrant(complement);
+}
+
+// Pitch helpers
+inline float semitonesToRatio(float semitones) {
+    return fastExp2(semitones * (1.0f / 12.0f));
+}
+
+inline float centsToRatio(float cents) {
+    return fastExp2(cents * (1.0f / 1200.0f));
+}
+
+} // namespace phj
@@ -16,6 +16,9 @@ Filter::Filter()
     , stage4_(0.0f)
     , g_(0.0f)
     , k_(0.0f)
+    , coeffInterval_(1)
+    , coeffCounter_(0)
+    , gStep_(0.0f)
     , hpfState_(0.0f)
     , hpfG_(0.0f)
 {
@@ -29,7 +32,13 @@ void Filter::setSampleRate(float sampleRate) {
 
 void Filter::setParameters(const FilterParams& params) {
     params_ = params;
-    updateCoefficients();
+    // Cutoff changes are picked up (and ramped) at the next control tick
+    updateStaticCoefficients();
+}
+
+void Filter::setCoefficientInterval(int samples) {
+    coeffInterval_ = samples < 1 ? 1 : samples;
+    coeffCounter_ = 0;
 }
 
 void Filter::setEnvValue(float envValue) {
@@ -61,8 +70,17 @@ void Filter::reset() {
 }
 
 Sample Filter::process(Sample input) {
-    // Update coefficients to apply modulation (envelope, LFO, velocity, key tracking)
-    updateCoefficients();
+    input = processInput(input);
+
+    // ZDF 4-pole ladder filter
+    // Based on Vadim Zavalishin's "The Art of VA Filter Design"
+    // Output is the 4th stage (4-pole = 24dB/octave)
+    return processLadder(input);
+}
+
+Sample Filter::processInput(Sample input) {
+    // Update cutoff to apply modulation (envelope, LFO, velocity, key tracking)
+    updateCutoffCoefficient();
 
     // Safety: Check for NaN or infinity in input
     if (!std::isfinite(input)) {
@@ -76,49 +94,7 @@ Sample Filter::process(Sample input) {
 
     // Apply input drive/saturation
     input *= params_.drive;
-    input = saturate(input);
-
-    // ZDF 4-pole ladder filter
-    // Based on Vadim Zavalishin's "The Art of VA Filter Design"
-
-    // Calculate normalized gain and feedback compensation
-    // CRITICAL: Without compensation, filter becomes unstable and produces NaN
-    float G = g_ / (1.0f + g_);  // Normalized cutoff per stage
-    float G4 = G * G * G * G;     // Total gain through 4 stages
-
-    // Calculate feedback with stability compensation
-    float feedback = k_ * stage4_;
-    float inputCompensated = (input - feedback) / (1.0f + k_ * G4);
-
-    // Process through 4 stages using TPT (Topology Preserving Transform)
-    float v1 = (inputCompensated - stage1_) * g_;
-    float out1 = v1 + stage1_;
-    stage1_ = out1 + v1;
-
-    float v2 = (out1 - stage2_) * g_;
-    float out2 = v2 + stage2_;
-    stage2_ = out2 + v2;
-
-    float v3 = (out2 - stage3_) * g_;
-    float out3 = v3 + stage3_;
-    stage3_ = out3 + v3;
-
-    float v4 = (out3 - stage4_) * g_;
-    float out4 = v4 + stage4_;
-    stage4_ = out4 + v4;
-
-    // Safety: Check for denormals and NaN in filter states
-    // This prevents filter blow-up and denormal performance issues
-    if (!std::isfinite(stage1_) || std::abs(stage1_) < 1e-30f) stage1_ = 0.0f;
-    if (!std::isfinite(stage2_) || std::abs(stage2_) < 1e-30f) stage2_ = 0.0f;
-    if (!std::isfinite(stage3_) || std::abs(stage3_) < 1e-30f) stage3_ = 0.0f;
-    if (!std::isfinite(stage4_) || std::abs(stage4_) < 1e-30f) stage4_ = 0.0f;
-
-    // Safety: Clamp output to prevent clipping artifacts
-    out4 = clamp(out4, -2.0f, 2.0f);
-
-    // Output is the 4th stage (4-pole = 24dB/octave)
-    return out4;
+    return saturate(input);
 }
 
 void Filter::process(const Sample* input, Sample* output, int numSamples) {
@@ -128,6 +104,46 @@ void Filter::process(const Sample* input, Sample* output, int numSamples) {
 }
 
 void Filter::updateCoefficients() {
+    g_ = calculateCutoffCoefficient();
+    gStep_ = 0.0f;
+    coeffCounter_ = 0;
+    updateStaticCoefficients();
+}
+
+void Filter::updateStaticCoefficients() {
+    // Calculate resonance coefficient
+    // k controls feedback amount (0.0 = no resonance, 4.0 = self-oscillation)
+    // Map resonance parameter (0-1) to k (0-4)
+    k_ = clamp(params_.resonance, 0.0f, 1.0f) * 4.0f;
+
+    // M11: Calculate HPF coefficient based on mode
+    // Mode 0 = Off, 1 = 30Hz, 2 = 60Hz, 3 = 120Hz
+    if (params_.hpfMode > 0) {
+        float hpfCutoff = 30.0f * static_cast<float>(1 << (params_.hpfMode - 1));  // 30, 60, 120 Hz
+        float hpfWc = TWO_PI * hpfCutoff / sampleRate_;
+        hpfG_ = fastTan(hpfWc * 0.5f);
+    }
+}
+
+void Filter::updateCutoffCoefficient() {
+    if (coeffInterval_ <= 1) {
+        g_ = calculateCutoffCoefficient();
+        return;
+    }
+
+    // Control tick: aim at the current target and ramp g_ towards it
+    // over the next interval, so modulation stays smooth between ticks
+    if (coeffCounter_ <= 0) {
+        float target = calculateCutoffCoefficient();
+        gStep_ = (target - g_) / static_cast<float>(coeffInterval_);
+        coeffCounter_ = coeffInterval_;
+    }
+
+    g_ += gStep_;
+    --coeffCounter_;
+}
+
+float Filter::calculateCutoffCoefficient() {
     float cutoffHz = calculateCutoffHz();
 
     // Clamp cutoff to valid range
@@ -141,44 +157,38 @@ void Filter::updateCoefficients() {
     // Calculate g coefficient (normalized cutoff)
     // g = tan(pi * fc / fs) for bilinear transform
     float wc = TWO_PI * cutoffHz / sampleRate_;
-    g_ = std::tan(wc * 0.5f);
+    float g = fastTan(wc * 0.5f);
 
     // Safety: Clamp g to prevent extreme values
-    g_ = clamp(g_, 0.0f, 10.0f);
-
-    // Calculate resonance coefficient
-    // k controls feedback amount (0.0 = no resonance, 4.0 = self-oscillation)
-    // Map resonance parameter (0-1) to k (0-4)
-    k_ = clamp(params_.resonance, 0.0f, 1.0f) * 4.0f;
-
-    // M11: Calculate HPF coefficient based on mode
-    // Mode 0 = Off, 1 = 30Hz, 2 = 60Hz, 3 = 120Hz
-    if (params_.hpfMode > 0) {
-        float hpfCutoff = 30.0f * std::pow(2.0f, params_.hpfMode - 1);  // 30, 60, 120 Hz
-        float hpfWc = TWO_PI * hpfCutoff / sampleRate_;
-        hpfG_ = std::tan(hpfWc * 0.5f);
-    }
+    return clamp(g, 0.0f, 10.0f);
 }
 
 float Filter::calculateCutoffHz() {
+    // All exponential modulation is summed in semitones and converted to a
+    // frequency ratio with a single fastExp2 call
+
     // Base cutoff (logarithmic mapping from 0-1 to 20Hz-20kHz)
-    float baseCutoff = 20.0f * std::pow(1000.0f, params_.cutoff);
+    // 1000^cutoff = 2^(cutoff * log2(1000)), 12 * log2(1000) ≈ 119.59 semitones
+    float semitones = params_.cutoff * 119.589411f;
 
     // Envelope modulation (bipolar: -1 to +1)
     // Modulates cutoff in semitones
-    float envMod = 1.0f;  // Initialize to 1.0 (no modulation)
     if (params_.envAmount != 0.0f) {
         // Map envelope amount to ±48 semitones (4 octaves)
-        float envSemitones = params_.envAmount * 48.0f * envValue_;
-        envMod = std::pow(2.0f, envSemitones / 12.0f);
+        semitones += params_.envAmount * 48.0f * envValue_;
     }
 
     // LFO modulation
-    float lfoMod = 1.0f;
     if (params_.lfoAmount > 0.0f) {
         // LFO modulates ±24 semitones (2 octaves)
-        float lfoSemitones = lfoValue_ * params_.lfoAmount * 24.0f;
-        lfoMod = std::pow(2.0f, lfoSemitones / 12.0f);
+        semitones += lfoValue_ * params_.lfoAmount * 24.0f;
+    }
+
+    // M14: Velocity modulation
+    if (velocityAmount_ > 0.0f) {
+        // Velocity modulates ±24 semitones (2 octaves) scaled by amount
+        // Higher velocity opens the filter
+        semitones += (velocityValue_ - 0.5f) * 2.0f * velocityAmount_ * 24.0f;
     }
 
     // Key tracking
@@ -196,17 +206,8 @@ float Filter::calculateCutoffHz() {
         }
     }
 
-    // M14: Velocity modulation
-    float velocityMod = 1.0f;
-    if (velocityAmount_ > 0.0f) {
-        // Velocity modulates ±24 semitones (2 octaves) scaled by amount
-        // Higher velocity opens the filter
-        float velocitySemitones = (velocityValue_ - 0.5f) * 2.0f * velocityAmount_ * 24.0f;
-        velocityMod = std::pow(2.0f, velocitySemitones / 12.0f);
-    }
-
     // Combine all modulations (multiplicative)
-    float finalCutoff = baseCutoff * envMod * lfoMod * keyTrackMod * velocityMod;
+    float finalCutoff = 20.0f * semitonesToRatio(semitones) * keyTrackMod;
 
     return finalCutoff;
 }
@@ -30,6 +30,11 @@ public:
     void setNoteFrequency(float noteFreq);  // For key tracking
     void setVelocityValue(float velocity, float amount);  // M14: Velocity modulation
 
+    // Control-rate cutoff: recompute the cutoff coefficient every N samples
+    // and interpolate linearly in between (1 = recompute every sample)
+    void setCoefficientInterval(int samples);
+    int getCoefficientInterval() const { return coeffInterval_; }
+
     void reset();
 
     // Process single sample
@@ -38,6 +43,50 @@ public:
     // Process buffer
     void process(const Sample* input, Sample* output, int numSamples);
 
+    // Split processing for lane-parallel rendering (see VoiceBank):
+    // processInput() updates the coefficients and applies HPF and drive,
+    // processLadder() runs the ladder on this filter's own state, and
+    // ladderTick() runs it on external (per-lane) state.
+    Sample processInput(Sample input);
+    Sample processLadder(Sample input) {
+        return ladderTick(input, g_, k_, stage1_, stage2_, stage3_, stage4_);
+    }
+    float getCutoffCoefficient() const { return g_; }
+    float getResonanceCoefficient() const { return k_; }
+
+    // One sample of the ZDF 4-pole ladder on the given stage state.
+    // Branch-free so it vectorizes when run across voice lanes.
+    static inline Sample ladderTick(Sample input, float g, float k,
+                                    float& s1, float& s2, float& s3, float& s4) {
+        // Calculate normalized gain and feedback compensation
+        // CRITICAL: Without compensation, filter becomes unstable and produces NaN
+        float G = g / (1.0f + g);   // Normalized cutoff per stage
+        float G4 = G * G * G * G;   // Total gain through 4 stages
+
+        // Calculate feedback with stability compensation
+        float inputCompensated = (input - k * s4) / (1.0f + k * G4);
+
+        // Process through 4 stages using TPT (Topology Preserving Transform)
+        float v1 = (inputCompensated - s1) * g;
+        float out1 = v1 + s1;
+        s1 = flushState(out1 + v1);
+
+        float v2 = (out1 - s2) * g;
+        float out2 = v2 + s2;
+        s2 = flushState(out2 + v2);
+
+        float v3 = (out2 - s3) * g;
+        float out3 = v3 + s3;
+        s3 = flushState(out3 + v3);
+
+        float v4 = (out3 - s4) * g;
+        float out4 = v4 + s4;
+        s4 = flushState(out4 + v4);
+
+        // Safety: Clamp output to prevent clipping artifacts
+        return out4 < -2.0f ? -2.0f : (out4 > 2.0f ? 2.0f : out4);
+    }
+
 private:
     float sampleRate_;
     FilterParams params_;
@@ -59,12 +108,27 @@ private:
     float g_;           // Cutoff coefficient
     float k_;           // Resonance coefficient
 
+    // Control-rate cutoff interpolation
+    int coeffInterval_;     // Samples between cutoff recomputes
+    int coeffCounter_;      // Samples left until the next recompute
+    float gStep_;           // Per-sample g_ increment towards the next target
+
     // M11: HPF state (1-pole high-pass filter)
     float hpfState_;
     float hpfG_;        // HPF cutoff coefficient
 
+    // Safety: zero denormal and non-finite filter states
+    // This prevents filter blow-up and denormal performance issues
+    static inline float flushState(float x) {
+        float a = std::abs(x);
+        return (a < 1e-30f || !(a <= 3.0e38f)) ? 0.0f : x;
+    }
+
     // Helper methods
-    void updateCoefficients();
+    void updateCoefficients();          // Cutoff, resonance and HPF (immediate)
+    void updateStaticCoefficients();    // Resonance and HPF (parameter changes only)
+    void updateCutoffCoefficient();     // Cutoff at control rate
+    float calculateCutoffCoefficient();
     float calculateCutoffHz();
     float saturate(float x);  // Soft saturation
     float processHPF(float input);  // M11: High-pass filter processing
@@ -68,6 +68,12 @@ float Lfo::process() {
     return clamp(value * delayScale_, -1.0f, 1.0f);
 }
 
+void Lfo::process(float* output, int numSamples) {
+    for (int i = 0; i < numSamples; ++i) {
+        output[i] = process();
+    }
+}
+
 void Lfo::updatePhaseIncrement() {
     phaseIncrement_ = rateHz_ / sampleRate_;
 }
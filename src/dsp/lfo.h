@@ -25,6 +25,9 @@ public:
     // The value is automatically scaled during the delay period
     float process();
 
+    // Render a block of LFO values (control block for the voices)
+    void process(float* output, int numSamples);
+
     float getRate() const { return rateHz_; }
     float getDelay() const { return delaySeconds_; }
 
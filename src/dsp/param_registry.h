@@ -0,0 +1,278 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "types.h"
+#include "parameters.h"
+
+namespace phj {
+
+/**
+ * Parameter registry - one descriptor per ParamId
+ *
+ * Each descriptor names the parameter struct and field it writes, its range
+ * in plain units, the curve that maps a normalized 0-1 control value onto
+ * that range, and a smoothing time for continuous controls. Synth::setParam
+ * dispatches through this table in O(1), and MIDI CCs are routed through
+ * CC_MAP, so the Pi and web builds share one mapping.
+ *
+ * The table and the CC map are constexpr. Exponential curves are evaluated
+ * with fastExp2 from a log2 ratio computed at compile time, so there is no
+ * std::pow per message.
+ */
+
+// Parameter struct a descriptor writes into
+enum class ParamTarget : uint8_t {
+    Dco,
+    Filter,
+    FilterEnv,
+    AmpEnv,
+    Lfo,
+    Chorus,
+    Performance
+};
+
+enum class ParamType : uint8_t {
+    Float,
+    Int,
+    Bool
+};
+
+// Normalized (0-1) -> value mapping
+enum class ParamCurve : uint8_t {
+    Linear,       // min + x * (max - min)
+    Exponential,  // min * (max / min)^x  (min > 0)
+    Quadratic,    // min + x^2 * (max - min)
+    Stepped       // Integers min..max in equal slices of the control range
+};
+
+struct ParamDescriptor {
+    ParamId id;
+    const char* name;
+    ParamTarget target;
+    uint16_t offset;      // Field offset within the target struct
+    ParamType type;
+    ParamCurve curve;
+    float min;            // Plain units
+    float max;
+    float smoothingMs;    // Glide time for continuous controls (0 = step)
+    float log2Ratio;      // log2(max / min), for Exponential
+};
+
+namespace params {
+
+static_assert(std::is_standard_layout<DcoParams>::value &&
+              std::is_standard_layout<FilterParams>::value &&
+              std::is_standard_layout<EnvelopeParams>::value &&
+              std::is_standard_layout<LfoParams>::value &&
+              std::is_standard_layout<ChorusParams>::value &&
+              std::is_standard_layout<PerformanceParams>::value,
+              "Parameter structs are addressed by field offset");
+
+constexpr ParamDescriptor make(ParamId id, const char* name, ParamTarget target, size_t offset,
+                               ParamType type, ParamCurve curve, float min, float max,
+                               float smoothingMs = 0.0f) {
+    return {id, name, target, static_cast<uint16_t>(offset), type, curve, min, max, smoothingMs,
+            curve == ParamCurve::Exponential ? static_cast<float>(fastmath::constexprLog2(max / min)) : 0.0f};
+}
+
+// Entries are in ParamId order (checked below)
+constexpr ParamDescriptor TABLE[] = {
+    // DCO
+    make(ParamId::DCO_SAW_LEVEL, "dco.sawLevel", ParamTarget::Dco, offsetof(DcoParams, sawLevel), ParamType::Float, ParamCurve::Linear, 0.0f, 1.0f, 5.0f),
+    make(ParamId::DCO_PULSE_LEVEL, "dco.pulseLevel", ParamTarget::Dco, offsetof(DcoParams, pulseLevel), ParamType::Float, ParamCurve::Linear, 0.0f, 1.0f, 5.0f),
+    make(ParamId::DCO_SUB_LEVEL, "dco.subLevel", ParamTarget::Dco, offsetof(DcoParams, subLevel), ParamType::Float, ParamCurve::Linear, 0.0f, 1.0f, 5.0f),
+    make(ParamId::DCO_NOISE_LEVEL, "dco.noiseLevel", ParamTarget::Dco, offsetof(DcoParams, noiseLevel), ParamType::Float, ParamCurve::Linear, 0.0f, 1.0f, 5.0f),
+    make(ParamId::DCO_PULSE_WIDTH, "dco.pulseWidth", ParamTarget::Dco, offsetof(DcoParams, pulseWidth), ParamType::Float, ParamCurve::Linear, 0.05f, 0.95f, 10.0f),
+    make(ParamId::DCO_PWM_DEPTH, "dco.pwmDepth", ParamTarget::Dco, offsetof(DcoParams, pwmDepth), ParamType::Float, ParamCurve::Linear, 0.0f, 1.0f, 10.0f),
+    make(ParamId::DCO_LFO_TARGET, "dco.lfoTarget", ParamTarget::Dco, offsetof(DcoParams, lfoTarget), ParamType::Int, ParamCurve::Stepped, 0.0f, 3.0f),
+    make(ParamId::DCO_RANGE, "dco.range", ParamTarget::Dco, offsetof(DcoParams, range), ParamType::Int, ParamCurve::Stepped, 0.0f, 2.0f),
+    make(ParamId::DCO_DETUNE, "dco.detune", ParamTarget::Dco, offsetof(DcoParams, detune), ParamType::Float, ParamCurve::Linear, -10.0f, 10.0f),
+    make(ParamId::DCO_DRIFT, "dco.drift", ParamTarget::Dco, offsetof(DcoParams, enableDrift), ParamType::Bool, ParamCurve::Stepped, 0.0f, 1.0f),
+
+    // Filter
+    make(ParamId::FILTER_CUTOFF, "filter.cutoff", ParamTarget::Filter, offsetof(FilterParams, cutoff), ParamType::Float, ParamCurve::Linear, 0.0f, 1.0f, 10.0f),
+    make(ParamId::FILTER_RESONANCE, "filter.resonance", ParamTarget::Filter, offsetof(FilterParams, resonance), ParamType::Float, ParamCurve::Linear, 0.0f, 1.0f, 10.0f),
+    make(ParamId::FILTER_ENV_AMOUNT, "filter.envAmount", ParamTarget::Filter, offsetof(FilterParams, envAmount), ParamType::Float, ParamCurve::Linear, -1.0f, 1.0f, 10.0f),
+    make(ParamId::FILTER_LFO_AMOUNT, "filter.lfoAmount", ParamTarget::Filter, offsetof(FilterParams, lfoAmount), ParamType::Float, ParamCurve::Linear, 0.0f, 1.0f, 10.0f),
+    make(ParamId::FILTER_KEY_TRACK, "filter.keyTrack", ParamTarget::Filter, offsetof(FilterParams, keyTrack), ParamType::Int, ParamCurve::Stepped, 0.0f, 2.0f),
+    make(ParamId::FILTER_HPF_MODE, "filter.hpfMode", ParamTarget::Filter, offsetof(FilterParams, hpfMode), ParamType::Int, ParamCurve::Stepped, 0.0f, 3.0f),
+
+    // Envelopes (seconds; sustain is a level)
+    make(ParamId::FILTER_ENV_ATTACK, "filterEnv.attack", ParamTarget::FilterEnv, offsetof(EnvelopeParams, attack), ParamType::Float, ParamCurve::Exponential, 0.001f, 3.0f),
+    make(ParamId::FILTER_ENV_DECAY, "filterEnv.decay", ParamTarget::FilterEnv, offsetof(EnvelopeParams, decay), ParamType::Float, ParamCurve::Exponential, 0.002f, 12.0f),
+    make(ParamId::FILTER_ENV_SUSTAIN, "filterEnv.sustain", ParamTarget::FilterEnv, offsetof(EnvelopeParams, sustain), ParamType::Float, ParamCurve::Linear, 0.0f, 1.0f),
+    make(ParamId::FILTER_ENV_RELEASE, "filterEnv.release", ParamTarget::FilterEnv, offsetof(EnvelopeParams, release), ParamType::Float, ParamCurve::Exponential, 0.002f, 12.0f),
+
+    make(ParamId::AMP_ENV_ATTACK, "ampEnv.attack", ParamTarget::AmpEnv, offsetof(EnvelopeParams, attack), ParamType::Float, ParamCurve::Exponential, 0.001f, 3.0f),
+    make(ParamId::AMP_ENV_DECAY, "ampEnv.decay", ParamTarget::AmpEnv, offsetof(EnvelopeParams, decay), ParamType::Float, ParamCurve::Exponential, 0.002f, 12.0f),
+    make(ParamId::AMP_ENV_SUSTAIN, "ampEnv.sustain", ParamTarget::AmpEnv, offsetof(EnvelopeParams, sustain), ParamType::Float, ParamCurve::Linear, 0.0f, 1.0f),
+    make(ParamId::AMP_ENV_RELEASE, "ampEnv.release", ParamTarget::AmpEnv, offsetof(EnvelopeParams, release), ParamType::Float, ParamCurve::Exponential, 0.002f, 12.0f),
+
+    // LFO
+    make(ParamId::LFO_RATE, "lfo.rate", ParamTarget::Lfo, offsetof(LfoParams, rate), ParamType::Float, ParamCurve::Exponential, 0.1f, 30.0f),
+    make(ParamId::LFO_DELAY, "lfo.delay", ParamTarget::Lfo, offsetof(LfoParams, delay), ParamType::Float, ParamCurve::Linear, 0.0f, 3.0f),
+
+    // Chorus
+    make(ParamId::CHORUS_MODE, "chorus.mode", ParamTarget::Chorus, offsetof(ChorusParams, mode), ParamType::Int, ParamCurve::Stepped, 0.0f, 3.0f),
+
+    // M11: Performance
+    make(ParamId::PITCH_BEND, "performance.pitchBend", ParamTarget::Performance, offsetof(PerformanceParams, pitchBend), ParamType::Float, ParamCurve::Linear, -1.0f, 1.0f),
+    make(ParamId::PITCH_BEND_RANGE, "performance.pitchBendRange", ParamTarget::Performance, offsetof(PerformanceParams, pitchBendRange), ParamType::Float, ParamCurve::Linear, 0.0f, 12.0f),
+    make(ParamId::PORTAMENTO_TIME, "performance.portamentoTime", ParamTarget::Performance, offsetof(PerformanceParams, portamentoTime), ParamType::Float, ParamCurve::Quadratic, 0.0f, 10.0f),
+
+    // M13: Performance Controls
+    make(ParamId::MOD_WHEEL, "performance.modWheel", ParamTarget::Performance, offsetof(PerformanceParams, modWheel), ParamType::Float, ParamCurve::Linear, 0.0f, 1.0f, 5.0f),
+    make(ParamId::VCA_MODE, "performance.vcaMode", ParamTarget::Performance, offsetof(PerformanceParams, vcaMode), ParamType::Int, ParamCurve::Stepped, 0.0f, 1.0f),
+    make(ParamId::FILTER_ENV_POLARITY, "performance.filterEnvPolarity", ParamTarget::Performance, offsetof(PerformanceParams, filterEnvPolarity), ParamType::Int, ParamCurve::Stepped, 0.0f, 1.0f),
+
+    // M14: Range & Voice Control
+    make(ParamId::VCA_LEVEL, "performance.vcaLevel", ParamTarget::Performance, offsetof(PerformanceParams, vcaLevel), ParamType::Float, ParamCurve::Linear, 0.0f, 1.0f, 5.0f),
+    make(ParamId::MASTER_TUNE, "performance.masterTune", ParamTarget::Performance, offsetof(PerformanceParams, masterTune), ParamType::Float, ParamCurve::Linear, -50.0f, 50.0f, 10.0f),
+    make(ParamId::VELOCITY_TO_FILTER, "performance.velocityToFilter", ParamTarget::Performance, offsetof(PerformanceParams, velocityToFilter), ParamType::Float, ParamCurve::Linear, 0.0f, 1.0f),
+    make(ParamId::VELOCITY_TO_AMP, "performance.velocityToAmp", ParamTarget::Performance, offsetof(PerformanceParams, velocityToAmp), ParamType::Float, ParamCurve::Linear, 0.0f, 1.0f),
+
+    // M16: Voice allocation
+    make(ParamId::VOICE_ALLOCATION_MODE, "performance.voiceAllocationMode", ParamTarget::Performance, offsetof(PerformanceParams, voiceAllocationMode), ParamType::Int, ParamCurve::Stepped, 0.0f, 3.0f),
+
+    // Global: the output level is the VCA level
+    make(ParamId::MASTER_VOLUME, "masterVolume", ParamTarget::Performance, offsetof(PerformanceParams, vcaLevel), ParamType::Float, ParamCurve::Linear, 0.0f, 1.0f, 5.0f),
+};
+
+constexpr int COUNT = static_cast<int>(ParamId::PARAM_COUNT);
+
+constexpr bool tableInIdOrder() {
+    if (static_cast<int>(sizeof(TABLE) / sizeof(TABLE[0])) != COUNT) {
+        return false;
+    }
+    for (int i = 0; i < COUNT; ++i) {
+        if (static_cast<int>(TABLE[i].id) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(tableInIdOrder(), "One descriptor per ParamId, in enum order");
+
+// ----------------------------------------------------------------------------
+// MIDI CC assignments (Arturia MiniLab layout, see docs/architecture.md)
+// CC 64 (sustain) is a switch, not a parameter: Synth handles it directly.
+// ----------------------------------------------------------------------------
+
+struct CcAssignment {
+    uint8_t controller;
+    ParamId id;
+};
+
+constexpr CcAssignment CC_ASSIGNMENTS[] = {
+    {1, ParamId::VCA_LEVEL},            // Mod wheel drives the volume on the MiniLab
+    {7, ParamId::MASTER_VOLUME},
+    {14, ParamId::DCO_SAW_LEVEL},
+    {15, ParamId::DCO_PULSE_LEVEL},
+    {16, ParamId::DCO_SUB_LEVEL},
+    {17, ParamId::DCO_NOISE_LEVEL},
+    {18, ParamId::DCO_LFO_TARGET},
+    {19, ParamId::DCO_RANGE},
+    {20, ParamId::FILTER_LFO_AMOUNT},
+    {21, ParamId::FILTER_KEY_TRACK},
+    {22, ParamId::FILTER_HPF_MODE},
+    {23, ParamId::VCA_MODE},
+    {24, ParamId::FILTER_ENV_POLARITY},
+    {25, ParamId::VCA_LEVEL},
+    {26, ParamId::MASTER_TUNE},
+    {27, ParamId::VELOCITY_TO_FILTER},
+    {28, ParamId::VELOCITY_TO_AMP},
+    {29, ParamId::VOICE_ALLOCATION_MODE},
+    {71, ParamId::FILTER_RESONANCE},
+    {73, ParamId::FILTER_ENV_AMOUNT},
+    {74, ParamId::FILTER_CUTOFF},
+    {75, ParamId::LFO_RATE},
+    {76, ParamId::LFO_DELAY},
+    {77, ParamId::DCO_PULSE_WIDTH},
+    {78, ParamId::DCO_PWM_DEPTH},
+    {79, ParamId::FILTER_ENV_ATTACK},
+    {80, ParamId::FILTER_ENV_DECAY},
+    {81, ParamId::FILTER_ENV_SUSTAIN},
+    {82, ParamId::FILTER_ENV_RELEASE},
+    {83, ParamId::AMP_ENV_ATTACK},
+    {84, ParamId::AMP_ENV_DECAY},
+    {85, ParamId::AMP_ENV_SUSTAIN},
+    {86, ParamId::AMP_ENV_RELEASE},
+    {91, ParamId::CHORUS_MODE},
+    {102, ParamId::PORTAMENTO_TIME},
+    {103, ParamId::PITCH_BEND_RANGE},
+};
+
+constexpr std::array<ParamId, 128> makeCcMap() {
+    std::array<ParamId, 128> map{};
+    for (ParamId& id : map) {
+        id = ParamId::PARAM_COUNT;  // Unassigned
+    }
+    for (const CcAssignment& assignment : CC_ASSIGNMENTS) {
+        map[assignment.controller] = assignment.id;
+    }
+    return map;
+}
+
+} // namespace params
+
+// Controller number -> parameter (PARAM_COUNT when unassigned)
+constexpr std::array<ParamId, 128> CC_MAP = params::makeCcMap();
+
+constexpr const ParamDescriptor& paramDescriptor(ParamId id) {
+    return params::TABLE[static_cast<int>(id)];
+}
+
+constexpr bool isValidParam(ParamId id) {
+    return static_cast<unsigned>(id) < static_cast<unsigned>(ParamId::PARAM_COUNT);
+}
+
+// Address of a descriptor's field within a Patch
+inline char* paramField(Patch& patch, const ParamDescriptor& desc) {
+    char* base;
+    switch (desc.target) {
+        case ParamTarget::Dco: base = reinterpret_cast<char*>(&patch.dco); break;
+        case ParamTarget::Filter: base = reinterpret_cast<char*>(&patch.filter); break;
+        case ParamTarget::FilterEnv: base = reinterpret_cast<char*>(&patch.filterEnv); break;
+        case ParamTarget::AmpEnv: base = reinterpret_cast<char*>(&patch.ampEnv); break;
+        case ParamTarget::Lfo: base = reinterpret_cast<char*>(&patch.lfo); break;
+        case ParamTarget::Chorus: base = reinterpret_cast<char*>(&patch.chorus); break;
+        case ParamTarget::Performance:
+        default: base = reinterpret_cast<char*>(&patch.performance); break;
+    }
+    return base + desc.offset;
+}
+
+inline const char* paramField(const Patch& patch, const ParamDescriptor& desc) {
+    return paramField(const_cast<Patch&>(patch), desc);
+}
+
+inline ParamId ccToParam(int controller) {
+    return (controller >= 0 && controller < 128) ? CC_MAP[controller] : ParamId::PARAM_COUNT;
+}
+
+/**
+ * Map a normalized control value (clamped to 0-1) to plain units.
+ * Stepped parameters return a whole number.
+ */
+inline float paramValueFromNormalized(const ParamDescriptor& desc, float normalized) {
+    const float x = clamp(normalized, 0.0f, 1.0f);
+    switch (desc.curve) {
+        case ParamCurve::Exponential:
+            return desc.min * fastExp2(x * desc.log2Ratio);
+        case ParamCurve::Quadratic:
+            return desc.min + x * x * (desc.max - desc.min);
+        case ParamCurve::Stepped: {
+            // Equal slices; the top value is reached just below 1.0
+            const float steps = desc.max - desc.min + 1.0f;
+            return desc.min + static_cast<float>(static_cast<int>(x * (steps - 0.01f)));
+        }
+        case ParamCurve::Linear:
+        default:
+            return desc.min + x * (desc.max - desc.min);
+    }
+}
+
+} // namespace phj
@@ -0,0 +1,94 @@
+#include "param_smoother.h"
+
+namespace phj {
+
+ParamSmoother::ParamSmoother()
+    : sampleRate_(SAMPLE_RATE)
+    , numActive_(0)
+{
+    for (int i = 0; i < COUNT; ++i) {
+        const ParamDescriptor& desc = paramDescriptor(static_cast<ParamId>(i));
+        ramps_[i] = {0.0f, 0.0f, 0.0f, 0, desc.type == ParamType::Float ? desc.smoothingMs : 0.0f};
+        active_[i] = ParamId::PARAM_COUNT;
+    }
+}
+
+void ParamSmoother::setSampleRate(float sampleRate) {
+    // Ramps in flight keep their increment; new ramps use the new rate
+    sampleRate_ = sampleRate;
+}
+
+void ParamSmoother::setTime(ParamId id, float ms) {
+    if (!isValidParam(id) || paramDescriptor(id).type != ParamType::Float) {
+        return;
+    }
+    ramps_[static_cast<int>(id)].timeMs = ms > 0.0f ? ms : 0.0f;
+}
+
+float ParamSmoother::getTime(ParamId id) const {
+    return isValidParam(id) ? ramps_[static_cast<int>(id)].timeMs : 0.0f;
+}
+
+bool ParamSmoother::start(ParamId id, float current, float target) {
+    if (!isValidParam(id)) {
+        return false;
+    }
+    Ramp& ramp = ramps_[static_cast<int>(id)];
+    const int samples = static_cast<int>(ramp.timeMs * 0.001f * sampleRate_);
+    if (samples <= 0) {
+        stop(id);
+        return false;
+    }
+
+    // One ramp per field: drop a ramp on an alias of this field
+    const ParamDescriptor& desc = paramDescriptor(id);
+    for (int i = 0; i < numActive_; ++i) {
+        const ParamDescriptor& other = paramDescriptor(active_[i]);
+        if (other.id != id && other.target == desc.target && other.offset == desc.offset) {
+            remove(i);
+            break;
+        }
+    }
+
+    if (ramp.remaining == 0) {
+        active_[numActive_++] = id;
+    }
+    ramp.current = current;
+    ramp.target = target;
+    ramp.increment = (target - current) / static_cast<float>(samples);
+    ramp.remaining = samples;
+    return true;
+}
+
+void ParamSmoother::stop(ParamId id) {
+    for (int i = 0; i < numActive_; ++i) {
+        if (active_[i] == id) {
+            remove(i);
+            return;
+        }
+    }
+}
+
+void ParamSmoother::stop(ParamTarget target) {
+    int i = 0;
+    while (i < numActive_) {
+        if (paramDescriptor(active_[i]).target == target) {
+            remove(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+void ParamSmoother::stopAll() {
+    while (numActive_ > 0) {
+        remove(numActive_ - 1);
+    }
+}
+
+void ParamSmoother::remove(int slot) {
+    ramps_[static_cast<int>(active_[slot])].remaining = 0;
+    active_[slot] = active_[--numActive_];
+}
+
+} // namespace phj
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include "types.h"
+#include "parameters.h"
+#include "param_registry.h"
+
+namespace phj {
+
+/**
+ * ParamSmoother - Linear ramps for continuous parameters, indexed by ParamId
+ *
+ * A CC moves a parameter in 1/127 steps. Instead of jumping, start() ramps
+ * the parameter from its current value to the new target over the
+ * parameter's smoothing time. The Synth advances the bank once per control
+ * block (SMOOTHING_INTERVAL samples while anything is moving) and writes the
+ * ramped values into the parameter structs.
+ *
+ * Ramps are linear so they end exactly on the target after a known number of
+ * samples; a one-pole would only approach it and need a threshold to stop.
+ * Only moving parameters are kept in the active list, so a bank at rest costs
+ * nothing and a sweep costs one add per moving parameter per control block.
+ *
+ * Times default to the descriptors' smoothingMs and can be changed per
+ * parameter; a time of zero (and any stepped parameter) applies immediately.
+ */
+class ParamSmoother {
+public:
+    ParamSmoother();
+
+    void setSampleRate(float sampleRate);
+
+    // Smoothing time per parameter (milliseconds, 0 = none). Only Float
+    // parameters can be smoothed; other ids are ignored.
+    void setTime(ParamId id, float ms);
+    float getTime(ParamId id) const;
+
+    // Ramp id from current to target. Returns false when the parameter is not
+    // smoothed: the caller then writes the target directly. A ramp replaces
+    // any ramp on the same field (VCA_LEVEL and MASTER_VOLUME share one).
+    bool start(ParamId id, float current, float target);
+
+    // Stop ramps where they are
+    void stop(ParamId id);
+    void stop(ParamTarget target);  // Every ramp on one parameter struct
+    void stopAll();
+
+    bool isActive() const { return numActive_ > 0; }
+    bool isActive(ParamId id) const { return isValidParam(id) && ramps_[static_cast<int>(id)].remaining > 0; }
+    float getTarget(ParamId id) const { return ramps_[static_cast<int>(id)].target; }
+
+    // Move every active ramp on by numSamples and call write(id, value) with
+    // each new value. Ramps that reach their target write it exactly and
+    // leave the active list.
+    template <typename Write>
+    void advance(int numSamples, Write&& write) {
+        int i = 0;
+        while (i < numActive_) {
+            const ParamId id = active_[i];
+            Ramp& ramp = ramps_[static_cast<int>(id)];
+            if (numSamples >= ramp.remaining) {
+                ramp.remaining = 0;
+                ramp.current = ramp.target;
+                active_[i] = active_[--numActive_];
+            } else {
+                ramp.remaining -= numSamples;
+                ramp.current += ramp.increment * static_cast<float>(numSamples);
+                ++i;
+            }
+            write(id, ramp.current);
+        }
+    }
+
+private:
+    static constexpr int COUNT = static_cast<int>(ParamId::PARAM_COUNT);
+
+    struct Ramp {
+        float current;
+        float target;
+        float increment;   // Per sample
+        int remaining;     // Samples to the target (0 = at rest)
+        float timeMs;
+    };
+
+    float sampleRate_;
+    Ramp ramps_[COUNT];
+    ParamId active_[COUNT];  // Moving parameters (unordered)
+    int numActive_;
+
+    void remove(int slot);
+};
+
+} // namespace phj
@@ -189,7 +189,24 @@ struct PerformanceParams {
 };
 
 /**
- * Parameter IDs for external control
+ * Patch - A complete sound: every parameter struct in one value
+ *
+ * Built off the audio thread and handed to the Synth whole (see
+ * Synth::postPatch), so a program change never applies half a sound.
+ */
+struct Patch {
+    DcoParams dco;
+    FilterParams filter;
+    EnvelopeParams filterEnv;
+    EnvelopeParams ampEnv;
+    LfoParams lfo;
+    ChorusParams chorus;
+    PerformanceParams performance;
+};
+
+/**
+ * Parameter IDs for external control (see param_registry.h for ranges,
+ * curves and MIDI CC assignments)
  */
 enum class ParamId {
     // DCO
@@ -201,6 +218,8 @@ enum class ParamId {
     DCO_PWM_DEPTH,
     DCO_LFO_TARGET,
     DCO_RANGE,  // M14
+    DCO_DETUNE,
+    DCO_DRIFT,
 
     // Filter
     FILTER_CUTOFF,
@@ -244,6 +263,9 @@ enum class ParamId {
     VELOCITY_TO_FILTER,
     VELOCITY_TO_AMP,
 
+    // M16: Voice allocation
+    VOICE_ALLOCATION_MODE,
+
     // Global
     MASTER_VOLUME,
 
@@ -0,0 +1,170 @@
+#include "patch_bank.h"
+#include <algorithm>
+#include <cstring>
+#include "param_registry.h"
+
+namespace phj {
+
+namespace {
+
+// Checked on the bit pattern: release builds use -ffast-math, which lets
+// the compiler assume std::isnan is always false
+bool isFinite(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x7F800000u) != 0x7F800000u;
+}
+
+// Clamp every registry parameter to its range (NaN and infinity go to the
+// minimum)
+void clampToRanges(Patch& patch) {
+    for (int i = 0; i < static_cast<int>(ParamId::PARAM_COUNT); ++i) {
+        const ParamDescriptor& desc = paramDescriptor(static_cast<ParamId>(i));
+        char* field = paramField(patch, desc);
+        if (desc.type == ParamType::Float) {
+            float& value = *reinterpret_cast<float*>(field);
+            value = isFinite(value) ? clamp(value, desc.min, desc.max) : desc.min;
+        } else if (desc.type == ParamType::Int) {
+            int& value = *reinterpret_cast<int*>(field);
+            value = std::max(static_cast<int>(desc.min), std::min(value, static_cast<int>(desc.max)));
+        }
+    }
+    // Not exposed as a parameter
+    patch.filter.drive = isFinite(patch.filter.drive) ? clamp(patch.filter.drive, 1.0f, 4.0f) : 1.0f;
+}
+
+} // namespace
+
+void encodePatch(const Patch& patch, const char* name, PatchRecord& record) {
+    std::memset(&record, 0, sizeof(record));
+    size_t length = 0;
+    while (name && length < PATCH_NAME_LENGTH && name[length] != '\0') {
+        ++length;
+    }
+    if (length > 0) {
+        std::memcpy(record.name, name, length);
+    }
+
+    record.sawLevel = patch.dco.sawLevel;
+    record.pulseLevel = patch.dco.pulseLevel;
+    record.subLevel = patch.dco.subLevel;
+    record.noiseLevel = patch.dco.noiseLevel;
+    record.pulseWidth = patch.dco.pulseWidth;
+    record.pwmDepth = patch.dco.pwmDepth;
+    record.lfoTarget = patch.dco.lfoTarget;
+    record.range = patch.dco.range;
+    record.detune = patch.dco.detune;
+    record.dcoFlags = patch.dco.enableDrift ? DCO_FLAG_DRIFT : 0u;
+
+    record.cutoff = patch.filter.cutoff;
+    record.resonance = patch.filter.resonance;
+    record.envAmount = patch.filter.envAmount;
+    record.lfoAmount = patch.filter.lfoAmount;
+    record.keyTrack = patch.filter.keyTrack;
+    record.drive = patch.filter.drive;
+    record.hpfMode = patch.filter.hpfMode;
+
+    const EnvelopeParams* envelopes[2] = {&patch.filterEnv, &patch.ampEnv};
+    float* stored[2] = {record.filterEnv, record.ampEnv};
+    for (int i = 0; i < 2; ++i) {
+        stored[i][0] = envelopes[i]->attack;
+        stored[i][1] = envelopes[i]->decay;
+        stored[i][2] = envelopes[i]->sustain;
+        stored[i][3] = envelopes[i]->release;
+    }
+
+    record.lfoRate = patch.lfo.rate;
+    record.lfoDelay = patch.lfo.delay;
+    record.chorusMode = patch.chorus.mode;
+
+    record.pitchBendRange = patch.performance.pitchBendRange;
+    record.portamentoTime = patch.performance.portamentoTime;
+    record.vcaMode = patch.performance.vcaMode;
+    record.filterEnvPolarity = patch.performance.filterEnvPolarity;
+    record.vcaLevel = patch.performance.vcaLevel;
+    record.masterTune = patch.performance.masterTune;
+    record.velocityToFilter = patch.performance.velocityToFilter;
+    record.velocityToAmp = patch.performance.velocityToAmp;
+    record.voiceAllocationMode = patch.performance.voiceAllocationMode;
+}
+
+Patch decodePatch(const PatchRecord& record) {
+    Patch patch;
+
+    patch.dco.sawLevel = record.sawLevel;
+    patch.dco.pulseLevel = record.pulseLevel;
+    patch.dco.subLevel = record.subLevel;
+    patch.dco.noiseLevel = record.noiseLevel;
+    patch.dco.pulseWidth = record.pulseWidth;
+    patch.dco.pwmDepth = record.pwmDepth;
+    patch.dco.lfoTarget = record.lfoTarget;
+    patch.dco.range = record.range;
+    patch.dco.detune = record.detune;
+    patch.dco.enableDrift = (record.dcoFlags & DCO_FLAG_DRIFT) != 0;
+
+    patch.filter.cutoff = record.cutoff;
+    patch.filter.resonance = record.resonance;
+    patch.filter.envAmount = record.envAmount;
+    patch.filter.lfoAmount = record.lfoAmount;
+    patch.filter.keyTrack = record.keyTrack;
+    patch.filter.drive = record.drive;
+    patch.filter.hpfMode = record.hpfMode;
+
+    EnvelopeParams* envelopes[2] = {&patch.filterEnv, &patch.ampEnv};
+    const float* stored[2] = {record.filterEnv, record.ampEnv};
+    for (int i = 0; i < 2; ++i) {
+        envelopes[i]->attack = stored[i][0];
+        envelopes[i]->decay = stored[i][1];
+        envelopes[i]->sustain = stored[i][2];
+        envelopes[i]->release = stored[i][3];
+    }
+
+    patch.lfo.rate = record.lfoRate;
+    patch.lfo.delay = record.lfoDelay;
+    patch.chorus.mode = record.chorusMode;
+
+    patch.performance.pitchBendRange = record.pitchBendRange;
+    patch.performance.portamentoTime = record.portamentoTime;
+    patch.performance.vcaMode = record.vcaMode;
+    patch.performance.filterEnvPolarity = record.filterEnvPolarity;
+    patch.performance.vcaLevel = record.vcaLevel;
+    patch.performance.masterTune = record.masterTune;
+    patch.performance.velocityToFilter = record.velocityToFilter;
+    patch.performance.velocityToAmp = record.velocityToAmp;
+    patch.performance.voiceAllocationMode = record.voiceAllocationMode;
+
+    clampToRanges(patch);
+    return patch;
+}
+
+BankHeader makeBankHeader(int count) {
+    BankHeader header;
+    std::memcpy(header.magic, BANK_MAGIC, sizeof(header.magic));
+    header.version = BANK_VERSION;
+    header.headerSize = sizeof(BankHeader);
+    header.recordSize = sizeof(PatchRecord);
+    header.count = static_cast<uint16_t>(count);
+    header.reserved = 0;
+    return header;
+}
+
+const PatchRecord* findBankRecords(const void* data, size_t size, int& count, size_t& recordSize) {
+    if (!data || size < sizeof(BankHeader) || reinterpret_cast<uintptr_t>(data) % alignof(PatchRecord) != 0) {
+        return nullptr;
+    }
+    BankHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, BANK_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != BANK_VERSION ||
+        header.headerSize < sizeof(BankHeader) || header.headerSize % alignof(PatchRecord) != 0 ||
+        header.recordSize < sizeof(PatchRecord) || header.recordSize % alignof(PatchRecord) != 0 ||
+        header.count == 0 || header.count > BANK_SIZE ||
+        size < header.headerSize + static_cast<size_t>(header.count) * header.recordSize) {
+        return nullptr;
+    }
+    count = header.count;
+    recordSize = header.recordSize;
+    return reinterpret_cast<const PatchRecord*>(static_cast<const char*>(data) + header.headerSize);
+}
+
+} // namespace phj
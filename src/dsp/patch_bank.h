@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include "parameters.h"
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "Patch bank records are little-endian and read in place"
+#endif
+
+namespace phj {
+
+/**
+ * Patch bank format - fixed-size binary patch records
+ *
+ * A bank is a 16-byte BankHeader followed by `count` PatchRecords of
+ * `recordSize` bytes each. Every field is a little-endian 32-bit value at a
+ * 4-byte aligned offset, so a bank mapped into memory (or fetched into a
+ * buffer) is read in place: finding a program is one multiply, and turning
+ * it into a Patch is a fixed sequence of field copies with no parsing.
+ *
+ * Versioning: `version` changes when the meaning of existing fields changes;
+ * fields added later go at the end of the record and grow `recordSize`, so a
+ * reader accepts any record at least as large as the one it knows.
+ *
+ * Pitch bend, mod wheel and sustain are playing state and are not stored.
+ */
+
+constexpr int BANK_SIZE = 128;             // One bank: MIDI programs 0-127
+constexpr uint16_t BANK_VERSION = 1;
+constexpr char BANK_MAGIC[4] = {'P', 'H', 'J', 'B'};
+constexpr int PATCH_NAME_LENGTH = 16;      // Bytes, NUL-padded (not terminated when full)
+
+struct BankHeader {
+    char magic[4];          // "PHJB"
+    uint16_t version;       // BANK_VERSION
+    uint16_t headerSize;    // sizeof(BankHeader): records start here
+    uint16_t recordSize;    // Bytes per record (>= sizeof(PatchRecord))
+    uint16_t count;         // Records in the file (1 - BANK_SIZE)
+    uint32_t reserved;      // 0
+};
+
+struct PatchRecord {
+    char name[PATCH_NAME_LENGTH];
+
+    // DCO
+    float sawLevel;
+    float pulseLevel;
+    float subLevel;
+    float noiseLevel;
+    float pulseWidth;
+    float pwmDepth;
+    int32_t lfoTarget;
+    int32_t range;
+    float detune;
+    uint32_t dcoFlags;              // DCO_FLAG_*
+
+    // Filter
+    float cutoff;
+    float resonance;
+    float envAmount;
+    float lfoAmount;
+    int32_t keyTrack;
+    float drive;
+    int32_t hpfMode;
+
+    // Envelopes (attack, decay, sustain, release)
+    float filterEnv[4];
+    float ampEnv[4];
+
+    // LFO and chorus
+    float lfoRate;
+    float lfoDelay;
+    int32_t chorusMode;
+
+    // Performance
+    float pitchBendRange;
+    float portamentoTime;
+    int32_t vcaMode;
+    int32_t filterEnvPolarity;
+    float vcaLevel;
+    float masterTune;
+    float velocityToFilter;
+    float velocityToAmp;
+    int32_t voiceAllocationMode;
+};
+
+constexpr uint32_t DCO_FLAG_DRIFT = 1u << 0;
+
+static_assert(sizeof(float) == 4 && std::numeric_limits<float>::is_iec559, "Records store IEEE 754 floats");
+static_assert(sizeof(BankHeader) == 16, "BankHeader layout is part of the file format");
+static_assert(sizeof(PatchRecord) == 164, "PatchRecord layout is part of the file format");
+static_assert(alignof(PatchRecord) == 4, "Records are read in place at 4-byte alignment");
+
+// Patch -> record (name is truncated to PATCH_NAME_LENGTH bytes)
+void encodePatch(const Patch& patch, const char* name, PatchRecord& record);
+
+// Record -> patch. Values are clamped to the parameter ranges (see
+// param_registry.h), so a damaged record cannot produce an unplayable patch.
+Patch decodePatch(const PatchRecord& record);
+
+// Header for a bank of count records
+BankHeader makeBankHeader(int count);
+
+// Check a bank image (size bytes at data, 4-byte aligned). Returns the first
+// record and sets count and recordSize, or returns nullptr if the image is
+// not a bank this reader understands.
+const PatchRecord* findBankRecords(const void* data, size_t size, int& count, size_t& recordSize);
+
+} // namespace phj
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace phj {
+
+/**
+ * Random - Small deterministic random number generator (PCG32)
+ *
+ * Replaces std::mt19937 + <random> distributions in the DSP core:
+ * - 16 bytes of state instead of ~5 KB per generator
+ * - Explicit seed and stream, so renders are reproducible
+ * - Independent streams for the same seed (one per voice)
+ * - Float conversion through the mantissa bits (no division)
+ *
+ * Reference: M.E. O'Neill, "PCG: A Family of Simple Fast Space-Efficient
+ * Statistically Good Algorithms for Random Number Generation" (pcg32).
+ */
+class Random {
+public:
+    static constexpr uint64_t DEFAULT_SEED = 0x853c49e6748fea9bULL;
+
+    explicit Random(uint64_t seed = DEFAULT_SEED, uint64_t stream = 0) {
+        setSeed(seed, stream);
+    }
+
+    void setSeed(uint64_t seed, uint64_t stream = 0) {
+        state_ = 0;
+        increment_ = (stream << 1) | 1u;  // Must be odd
+        nextUInt();
+        state_ += seed;
+        nextUInt();
+    }
+
+    // Uniform 32-bit integer
+    uint32_t nextUInt() {
+        uint64_t oldState = state_;
+        state_ = oldState * 6364136223846793005ULL + increment_;
+        uint32_t xorShifted = static_cast<uint32_t>(((oldState >> 18) ^ oldState) >> 27);
+        uint32_t rotation = static_cast<uint32_t>(oldState >> 59);
+        return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+    }
+
+    // Uniform float in [0, 1)
+    float nextFloat() {
+        // 23 random mantissa bits with exponent 0 -> [1, 2)
+        return bitsToFloat((nextUInt() >> 9) | 0x3f800000u) - 1.0f;
+    }
+
+    // Uniform float in [-1, 1)
+    float nextBipolar() {
+        // Exponent 1 -> [2, 4)
+        return bitsToFloat((nextUInt() >> 9) | 0x40000000u) - 3.0f;
+    }
+
+    // Approximate standard normal (Irwin-Hall: sum of 4 uniforms, unit variance)
+    // Bounded to about ±3.46 sigma, which is fine for modulation sources
+    float nextGaussian() {
+        float sum = nextBipolar() + nextBipolar() + nextBipolar() + nextBipolar();
+        return sum * 0.8660254f;  // sqrt(3/4): each bipolar uniform has variance 1/3
+    }
+
+private:
+    uint64_t state_;
+    uint64_t increment_;
+
+    static float bitsToFloat(uint32_t bits) {
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+};
+
+} // namespace phj
@@ -1,92 +1,258 @@
 #include "synth.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
 
 namespace phj {
 
 Synth::Synth()
     : sampleRate_(SAMPLE_RATE)
+    , noise_(Random::DEFAULT_SEED, NUM_VOICES)
+    , programLookup_(nullptr)
+    , programUserData_(nullptr)
+    , eventTiming_(false)
+    , blockTimestamp_(0)
+    , dirty_(0)
 {
+    std::memset(voiceDirty_, 0, sizeof(voiceDirty_));
+
     lfo_.setSampleRate(sampleRate_);
     chorus_.setSampleRate(sampleRate_);
 
     // Initialize all voices
     for (int i = 0; i < NUM_VOICES; ++i) {
         voices_[i].setSampleRate(sampleRate_);
-        voices_[i].setParameters(dcoParams_, filterParams_, filterEnvParams_, ampEnvParams_);
+        voices_[i].setParameters(patch_.dco, patch_.filter, patch_.filterEnv, patch_.ampEnv);
     }
 
     // Set default LFO parameters
-    lfo_.setRate(lfoParams_.rate);
-    lfo_.setDelay(lfoParams_.delay);  // M12
+    lfo_.setRate(patch_.lfo.rate);
+    lfo_.setDelay(patch_.lfo.delay);  // M12
 
     // Set default chorus mode
-    chorus_.setMode(static_cast<Chorus::Mode>(chorusParams_.mode));
+    chorus_.setMode(static_cast<Chorus::Mode>(patch_.chorus.mode));
 }
 
 void Synth::setSampleRate(float sampleRate) {
     sampleRate_ = sampleRate;
     lfo_.setSampleRate(sampleRate);
     chorus_.setSampleRate(sampleRate);
+    smoother_.setSampleRate(sampleRate);
 
-    for (int i = 0; i < NUM_VOICES; ++i) {
-        voices_[i].setSampleRate(sampleRate);
-    }
+    voices_.setSampleRate(sampleRate);
 }
 
 void Synth::setDcoParameters(const DcoParams& params) {
-    dcoParams_ = params;
-    for (int i = 0; i < NUM_VOICES; ++i) {
-        voices_[i].setParameters(dcoParams_, filterParams_, filterEnvParams_, ampEnvParams_);
-    }
+    patch_.dco = params;
+    smoother_.stop(ParamTarget::Dco);
+    markDirty(PARAM_DCO);
 }
 
 void Synth::setFilterParameters(const FilterParams& params) {
-    filterParams_ = params;
-    for (int i = 0; i < NUM_VOICES; ++i) {
-        voices_[i].setParameters(dcoParams_, filterParams_, filterEnvParams_, ampEnvParams_);
-    }
+    patch_.filter = params;
+    smoother_.stop(ParamTarget::Filter);
+    markDirty(PARAM_FILTER);
 }
 
 void Synth::setFilterEnvParameters(const EnvelopeParams& params) {
-    filterEnvParams_ = params;
-    for (int i = 0; i < NUM_VOICES; ++i) {
-        voices_[i].setParameters(dcoParams_, filterParams_, filterEnvParams_, ampEnvParams_);
-    }
+    patch_.filterEnv = params;
+    smoother_.stop(ParamTarget::FilterEnv);
+    markDirty(PARAM_FILTER_ENV);
 }
 
 void Synth::setAmpEnvParameters(const EnvelopeParams& params) {
-    ampEnvParams_ = params;
-    for (int i = 0; i < NUM_VOICES; ++i) {
-        voices_[i].setParameters(dcoParams_, filterParams_, filterEnvParams_, ampEnvParams_);
-    }
+    patch_.ampEnv = params;
+    smoother_.stop(ParamTarget::AmpEnv);
+    markDirty(PARAM_AMP_ENV);
 }
 
 void Synth::setLfoParameters(const LfoParams& params) {
-    lfoParams_ = params;
-    lfo_.setRate(lfoParams_.rate);
-    lfo_.setDelay(lfoParams_.delay);  // M12
+    patch_.lfo = params;
+    smoother_.stop(ParamTarget::Lfo);
+    markDirty(PARAM_LFO);
 }
 
 void Synth::setChorusParameters(const ChorusParams& params) {
-    chorusParams_ = params;
-    chorus_.setMode(static_cast<Chorus::Mode>(chorusParams_.mode));
+    patch_.chorus = params;
+    smoother_.stop(ParamTarget::Chorus);
+    markDirty(PARAM_CHORUS);
 }
 
 void Synth::setPerformanceParameters(const PerformanceParams& params) {
-    performanceParams_ = params;
-    // Update all voices with new performance parameters
-    for (int i = 0; i < NUM_VOICES; ++i) {
-        voices_[i].setPitchBend(performanceParams_.pitchBend, performanceParams_.pitchBendRange);
-        voices_[i].setPortamentoTime(performanceParams_.portamentoTime);
+    patch_.performance = params;
+    smoother_.stop(ParamTarget::Performance);
+    markDirty(PARAM_PERFORMANCE);
+}
+
+void Synth::setPatch(const Patch& patch) {
+    // Controllers keep their positions across program changes
+    const PerformanceParams live = patch_.performance;
+    patch_ = patch;
+    patch_.performance.pitchBend = live.pitchBend;
+    patch_.performance.modWheel = live.modWheel;
+    patch_.performance.sustainPedal = live.sustainPedal;
+
+    smoother_.stopAll();
+    markDirty(VOICE_PARAMS | PARAM_LFO | PARAM_CHORUS);
+}
+
+Patch Synth::getPatch() const {
+    Patch patch = patch_;
+    for (int i = 0; i < static_cast<int>(ParamId::PARAM_COUNT); ++i) {
+        const ParamId id = static_cast<ParamId>(i);
+        if (smoother_.isActive(id)) {
+            *reinterpret_cast<float*>(paramField(patch, paramDescriptor(id))) = smoother_.getTarget(id);
+        }
+    }
+    return patch;
+}
+
+void Synth::setProgramLookup(ProgramLookup lookup, void* userData) {
+    programLookup_ = lookup;
+    programUserData_ = userData;
+}
+
+void Synth::setParam(ParamId id, float normalized) {
+    if (!isValidParam(id)) {
+        return;
+    }
+    const ParamDescriptor& desc = paramDescriptor(id);
+    writeParam(desc, paramValueFromNormalized(desc, normalized));
+}
+
+void Synth::setParamValue(ParamId id, float value) {
+    if (!isValidParam(id)) {
+        return;
+    }
+    const ParamDescriptor& desc = paramDescriptor(id);
+    writeParam(desc, clamp(value, desc.min, desc.max));
+}
+
+float Synth::getParamValue(ParamId id) const {
+    if (!isValidParam(id)) {
+        return 0.0f;
+    }
+    if (smoother_.isActive(id)) {
+        return smoother_.getTarget(id);
+    }
+    const ParamDescriptor& desc = paramDescriptor(id);
+    const char* field = paramField(patch_, desc);
+    switch (desc.type) {
+        case ParamType::Int:
+            return static_cast<float>(*reinterpret_cast<const int*>(field));
+        case ParamType::Bool:
+            return *reinterpret_cast<const bool*>(field) ? 1.0f : 0.0f;
+        case ParamType::Float:
+        default:
+            return *reinterpret_cast<const float*>(field);
+    }
+}
+
+void Synth::writeParam(const ParamDescriptor& desc, float value) {
+    // Continuous parameters ramp from where they are; the smoother writes the
+    // field as it moves (see renderBlock)
+    if (desc.type == ParamType::Float) {
+        const float current = *reinterpret_cast<const float*>(paramField(patch_, desc));
+        if (smoother_.start(desc.id, current, value)) {
+            return;
+        }
+    }
+    storeParam(desc, value);
+}
+
+void Synth::storeParam(const ParamDescriptor& desc, float value) {
+    char* field = paramField(patch_, desc);
+    switch (desc.type) {
+        case ParamType::Int:
+            *reinterpret_cast<int*>(field) = static_cast<int>(std::floor(value + 0.5f));
+            break;
+        case ParamType::Bool:
+            *reinterpret_cast<bool*>(field) = value >= 0.5f;
+            break;
+        case ParamType::Float:
+        default:
+            *reinterpret_cast<float*>(field) = value;
+            break;
+    }
+
+    static constexpr uint8_t TARGET_GROUPS[] = {
+        PARAM_DCO, PARAM_FILTER, PARAM_FILTER_ENV, PARAM_AMP_ENV, PARAM_LFO, PARAM_CHORUS, PARAM_PERFORMANCE
+    };
+    markDirty(TARGET_GROUPS[static_cast<int>(desc.target)]);
+}
+
+void Synth::markDirty(uint8_t groups) {
+    dirty_ |= groups & ~VOICE_PARAMS;
+    if (groups & VOICE_PARAMS) {
+        for (int i = 0; i < NUM_VOICES; ++i) {
+            voiceDirty_[i] |= groups & VOICE_PARAMS;
+        }
+    }
+}
+
+void Synth::updateVoice(int index) {
+    const uint8_t dirty = voiceDirty_[index];
+    if (dirty == 0) {
+        return;
+    }
+    voiceDirty_[index] = 0;
+
+    Voice& voice = voices_[index];
+    if (dirty & PARAM_DCO) {
+        voice.setDcoParameters(patch_.dco);
+    }
+    if (dirty & PARAM_FILTER) {
+        voice.setFilterParameters(patch_.filter);
+    }
+    if (dirty & PARAM_FILTER_ENV) {
+        voice.setFilterEnvParameters(patch_.filterEnv);
+    }
+    if (dirty & PARAM_AMP_ENV) {
+        voice.setAmpEnvParameters(patch_.ampEnv);
+    }
+    if (dirty & PARAM_PERFORMANCE) {
+        voice.setPitchBend(patch_.performance.pitchBend, patch_.performance.pitchBendRange);
+        voice.setPortamentoTime(patch_.performance.portamentoTime);
         // M13: Update VCA mode and filter envelope polarity
-        voices_[i].setVcaMode(performanceParams_.vcaMode);
-        voices_[i].setFilterEnvPolarity(performanceParams_.filterEnvPolarity);
+        voice.setVcaMode(patch_.performance.vcaMode);
+        voice.setFilterEnvPolarity(patch_.performance.filterEnvPolarity);
         // M14: Update VCA level, velocity sensitivity, and master tune
-        voices_[i].setVcaLevel(performanceParams_.vcaLevel);
-        voices_[i].setVelocitySensitivity(performanceParams_.velocityToFilter, performanceParams_.velocityToAmp);
-        voices_[i].setMasterTune(performanceParams_.masterTune);
+        voice.setVcaLevel(patch_.performance.vcaLevel);
+        voice.setVelocitySensitivity(patch_.performance.velocityToFilter, patch_.performance.velocityToAmp);
+        voice.setMasterTune(patch_.performance.masterTune);
+    }
+}
+
+void Synth::applyParameterChanges() {
+    if (dirty_ & PARAM_LFO) {
+        lfo_.setRate(patch_.lfo.rate);
+        lfo_.setDelay(patch_.lfo.delay);  // M12
+    }
+    if (dirty_ & PARAM_CHORUS) {
+        chorus_.setMode(static_cast<Chorus::Mode>(patch_.chorus.mode));
+    }
+    dirty_ = 0;
+
+    // Idle voices keep their bits until note-on
+    for (int i = 0; i < NUM_VOICES; ++i) {
+        if (voiceDirty_[i] != 0 && voices_[i].isActive()) {
+            updateVoice(i);
+        }
+    }
+}
+
+void Synth::setFilterControlInterval(int samples) {
+    for (int i = 0; i < NUM_VOICES; ++i) {
+        voices_[i].setFilterControlInterval(samples);
     }
 }
 
+void Synth::setSeed(uint64_t seed) {
+    voices_.setSeed(seed);
+    noise_.setSeed(seed, NUM_VOICES);  // Stream after the voices' streams
+}
+
 int Synth::findFreeVoice() const {
     // First pass: find an inactive voice
     for (int i = 0; i < NUM_VOICES; ++i) {
@@ -113,7 +279,7 @@ int Synth::findVoiceToSteal() const {
 
         float score = 0.0f;
 
-        switch (performanceParams_.voiceAllocationMode) {
+        switch (patch_.performance.voiceAllocationMode) {
             case 0:  // VOICE_ALLOC_OLDEST (default)
                 score = voices_[i].getAge();  // Higher age = better candidate
                 break;
@@ -169,9 +335,10 @@ void Synth::handleNoteOn(int midiNote, float velocity) {
         voiceIndex = findVoiceToSteal();
     }
 
-    // If we found a voice, trigger it
+    // If we found a voice, bring its parameters up to date and trigger it
     if (voiceIndex != -1) {
-        voices_[voiceIndex].noteOn(midiNote, velocity);
+        updateVoice(voiceIndex);
+        voices_.noteOn(voiceIndex, midiNote, velocity);
         // M12: Trigger LFO delay timer on note-on
         lfo_.trigger();
     }
@@ -193,260 +360,205 @@ void Synth::allNotesOff() {
 }
 
 void Synth::handlePitchBend(float pitchBend) {
-    performanceParams_.pitchBend = clamp(pitchBend, -1.0f, 1.0f);
-    // Update all voices with new pitch bend value
-    for (int i = 0; i < NUM_VOICES; ++i) {
-        voices_[i].setPitchBend(performanceParams_.pitchBend, performanceParams_.pitchBendRange);
-    }
+    patch_.performance.pitchBend = clamp(pitchBend, -1.0f, 1.0f);
+    markDirty(PARAM_PERFORMANCE);
 }
 
 void Synth::handleModWheel(float modWheel) {
     // M13: Modulation wheel controls LFO depth (MIDI CC #1)
-    performanceParams_.modWheel = clamp(modWheel, 0.0f, 1.0f);
+    patch_.performance.modWheel = clamp(modWheel, 0.0f, 1.0f);
+    smoother_.stop(ParamId::MOD_WHEEL);
 }
 
 void Synth::handleControlChange(int controller, int value) {
-    // M16: Generic MIDI CC handler for Arturia MiniLab and other controllers
-    // Convert MIDI value (0-127) to normalized 0.0-1.0
-    float normalized = clamp(value / 127.0f, 0.0f, 1.0f);
-
-    switch (controller) {
-        case 1:  // Mod Wheel - map to volume for Arturia MiniLab
-            performanceParams_.vcaLevel = normalized;
-            setPerformanceParameters(performanceParams_);
-            break;
-
-        case 7:  // MIDI Volume (standard MIDI CC 7)
-            performanceParams_.vcaLevel = normalized;
-            setPerformanceParameters(performanceParams_);
-            break;
-
-        case 14:  // DCO Saw Level
-            dcoParams_.sawLevel = normalized;
-            setDcoParameters(dcoParams_);
-            break;
-
-        case 15:  // DCO Pulse Level
-            dcoParams_.pulseLevel = normalized;
-            setDcoParameters(dcoParams_);
-            break;
-
-        case 16:  // DCO Sub Level
-            dcoParams_.subLevel = normalized;
-            setDcoParameters(dcoParams_);
-            break;
-
-        case 17:  // DCO Noise Level
-            dcoParams_.noiseLevel = normalized;
-            setDcoParameters(dcoParams_);
-            break;
-
-        case 18:  // DCO LFO Target (0-3 discrete values)
-            dcoParams_.lfoTarget = static_cast<int>(normalized * 3.99f);
-            setDcoParameters(dcoParams_);
-            break;
-
-        case 19:  // DCO Range (0-2 discrete values: 16'/8'/4')
-            dcoParams_.range = static_cast<int>(normalized * 2.99f);
-            setDcoParameters(dcoParams_);
-            break;
-
-        case 20:  // Filter LFO Amount
-            filterParams_.lfoAmount = normalized;
-            setFilterParameters(filterParams_);
-            break;
-
-        case 21:  // Filter Key Track (0-2 discrete values)
-            filterParams_.keyTrack = static_cast<int>(normalized * 2.99f);
-            setFilterParameters(filterParams_);
-            break;
-
-        case 22:  // HPF Mode (0-3 discrete values)
-            filterParams_.hpfMode = static_cast<int>(normalized * 3.99f);
-            setFilterParameters(filterParams_);
-            break;
-
-        case 23:  // VCA Mode (0-1 discrete values: ENV/GATE)
-            performanceParams_.vcaMode = (value >= 64) ? 1 : 0;
-            setPerformanceParameters(performanceParams_);
-            break;
-
-        case 24:  // Filter Env Polarity (0-1 discrete values: Normal/Inverse)
-            performanceParams_.filterEnvPolarity = (value >= 64) ? 1 : 0;
-            setPerformanceParameters(performanceParams_);
-            break;
-
-        case 25:  // VCA Level
-            performanceParams_.vcaLevel = normalized;
-            setPerformanceParameters(performanceParams_);
-            break;
-
-        case 26:  // Master Tune (bipolar: -50 to +50 cents)
-            performanceParams_.masterTune = (normalized * 100.0f) - 50.0f;
-            setPerformanceParameters(performanceParams_);
-            break;
-
-        case 27:  // Velocity to Filter
-            performanceParams_.velocityToFilter = normalized;
-            setPerformanceParameters(performanceParams_);
-            break;
+    // M16: Generic MIDI CC handler (assignments in param_registry.h)
+    if (controller == 64) {  // Sustain Pedal
+        handleSustainPedal(value >= 64);  // Threshold at 64 for on/off
+        return;
+    }
+    ParamId id = ccToParam(controller);
+    if (id != ParamId::PARAM_COUNT) {
+        setParam(id, value / 127.0f);
+    }
+    // Unassigned CCs are ignored
+}
 
-        case 28:  // Velocity to Amp
-            performanceParams_.velocityToAmp = normalized;
-            setPerformanceParameters(performanceParams_);
-            break;
+void Synth::handleSustainPedal(bool sustain) {
+    // M16: Sustain pedal handling (CC #64)
+    patch_.performance.sustainPedal = sustain;
 
-        case 29:  // Voice Allocation Mode (0-3 discrete values)
-            performanceParams_.voiceAllocationMode = static_cast<int>(normalized * 3.99f);
-            setPerformanceParameters(performanceParams_);
-            break;
+    // Update all voices with new sustain state
+    for (int i = 0; i < NUM_VOICES; ++i) {
+        voices_[i].setSustained(sustain);
+    }
 
-        case 64:  // Sustain Pedal
-            handleSustainPedal(value >= 64);  // Threshold at 64 for on/off
-            break;
+    // When sustain is released, voices that were sustained will automatically
+    // release via the Voice::setSustained() method
+}
 
-        case 71:  // Filter Resonance
-            filterParams_.resonance = normalized;
-            setFilterParameters(filterParams_);
-            break;
+void Synth::handleMidiEvent(const MidiEvent& event) {
+    const uint8_t status = event.status & 0xF0;
 
-        case 73:  // Filter Env Amount (bipolar: -1.0 to 1.0)
-            filterParams_.envAmount = (normalized * 2.0f) - 1.0f;
-            setFilterParameters(filterParams_);
+    switch (status) {
+        case MIDI_NOTE_ON:
+            if (event.data2 > 0) {
+                handleNoteOn(event.data1, event.data2 / 127.0f);
+            } else {
+                // Velocity 0 is treated as Note OFF
+                handleNoteOff(event.data1);
+            }
             break;
 
-        case 74:  // Filter Cutoff (primary control)
-            filterParams_.cutoff = normalized;
-            setFilterParameters(filterParams_);
+        case MIDI_NOTE_OFF:
+            handleNoteOff(event.data1);
             break;
 
-        case 75: {  // LFO Rate (0.1 - 30.0 Hz, exponential scaling)
-            // Exponential mapping for musical control
-            float minRate = 0.1f;
-            float maxRate = 30.0f;
-            lfoParams_.rate = minRate * std::pow(maxRate / minRate, normalized);
-            setLfoParameters(lfoParams_);
+        case MIDI_CONTROL_CHANGE:
+            // M16: Handle all MIDI CC messages (including Arturia MiniLab support)
+            handleControlChange(event.data1, event.data2);
             break;
-        }
 
-        case 76: {  // LFO Delay (0.0 - 3.0 seconds)
-            lfoParams_.delay = normalized * 3.0f;
-            setLfoParameters(lfoParams_);
+        case MIDI_PITCH_BEND: {
+            // M11: Pitch bend - combine data1 (LSB) and data2 (MSB) into 14-bit value
+            int bendValue = event.data1 | (event.data2 << 7);
+            // Convert from 0-16383 to -1.0 to 1.0
+            handlePitchBend((bendValue - 8192) / 8192.0f);
             break;
         }
 
-        case 77:  // DCO Pulse Width (0.05 - 0.95)
-            dcoParams_.pulseWidth = 0.05f + (normalized * 0.9f);
-            setDcoParameters(dcoParams_);
-            break;
-
-        case 78:  // DCO PWM Depth (0.0 - 1.0)
-            dcoParams_.pwmDepth = normalized;
-            setDcoParameters(dcoParams_);
-            break;
-
-        case 79:  // Filter Env Attack (0.001 - 3.0 seconds, exponential)
-            filterEnvParams_.attack = 0.001f * std::pow(3000.0f, normalized);
-            setFilterEnvParameters(filterEnvParams_);
-            break;
-
-        case 80:  // Filter Env Decay (0.002 - 12.0 seconds, exponential)
-            filterEnvParams_.decay = 0.002f * std::pow(6000.0f, normalized);
-            setFilterEnvParameters(filterEnvParams_);
-            break;
-
-        case 81:  // Filter Env Sustain (0.0 - 1.0, linear)
-            filterEnvParams_.sustain = normalized;
-            setFilterEnvParameters(filterEnvParams_);
-            break;
-
-        case 82:  // Filter Env Release (0.002 - 12.0 seconds, exponential)
-            filterEnvParams_.release = 0.002f * std::pow(6000.0f, normalized);
-            setFilterEnvParameters(filterEnvParams_);
-            break;
-
-        case 83:  // Amp Env Attack (0.001 - 3.0 seconds, exponential)
-            ampEnvParams_.attack = 0.001f * std::pow(3000.0f, normalized);
-            setAmpEnvParameters(ampEnvParams_);
-            break;
-
-        case 84:  // Amp Env Decay (0.002 - 12.0 seconds, exponential)
-            ampEnvParams_.decay = 0.002f * std::pow(6000.0f, normalized);
-            setAmpEnvParameters(ampEnvParams_);
+        case MIDI_PROGRAM_CHANGE:
+            // The record is read in place and applied whole at this event's offset
+            if (programLookup_) {
+                if (const PatchRecord* record = programLookup_(event.data1, programUserData_)) {
+                    setPatch(decodePatch(*record));
+                }
+            }
             break;
 
-        case 85:  // Amp Env Sustain (0.0 - 1.0, linear)
-            ampEnvParams_.sustain = normalized;
-            setAmpEnvParameters(ampEnvParams_);
+        default:
+            // Other messages are ignored
             break;
+    }
+}
 
-        case 86:  // Amp Env Release (0.002 - 12.0 seconds, exponential)
-            ampEnvParams_.release = 0.002f * std::pow(6000.0f, normalized);
-            setAmpEnvParameters(ampEnvParams_);
-            break;
+void Synth::setBlockTimestamp(uint64_t timestamp) {
+    blockTimestamp_ = timestamp;
+    eventTiming_ = true;
+}
 
-        case 91:  // Chorus Mode (0-3 mapped to 4 discrete values)
-            chorusParams_.mode = static_cast<int>(normalized * 3.99f);  // 0, 1, 2, or 3
-            setChorusParameters(chorusParams_);
-            break;
+int Synth::eventOffset(const MidiEvent& event) const {
+    if (!eventTiming_ || event.timestamp <= blockTimestamp_) {
+        return 0;
+    }
+    double frames = static_cast<double>(event.timestamp - blockTimestamp_) * sampleRate_ * 1e-9;
+    return static_cast<int>(std::min(frames, 1e9));
+}
 
-        case 102: {  // Portamento Time (0.0 - 10.0 seconds, exponential)
-            performanceParams_.portamentoTime = normalized * normalized * 10.0f;
-            setPerformanceParameters(performanceParams_);
-            break;
+int Synth::applyEvents(int position, int maxSamples) {
+    // Events are queued in time order: apply everything that is due, stop at
+    // the first event that lies ahead and render up to it
+    while (const MidiEvent* next = events_.peek()) {
+        int offset = eventOffset(*next);
+        if (offset > position) {
+            return std::min(maxSamples, offset - position);
         }
+        MidiEvent event = *next;
+        events_.pop(event);
+        handleMidiEvent(event);
+    }
+    return maxSamples;
+}
 
-        case 103: {  // Pitch Bend Range (0 - 12 semitones)
-            performanceParams_.pitchBendRange = normalized * 12.0f;
-            setPerformanceParameters(performanceParams_);
-            break;
+void Synth::renderEvents(Sample* leftOutput, Sample* rightOutput, int numSamples) {
+    // Latest patch from the control thread, whole, before anything renders
+    if (patches_.update()) {
+        setPatch(patches_.read());
+    }
+
+    int offset = 0;
+    while (offset < numSamples) {
+        int blockSize = std::min(numSamples - offset, MAX_BUFFER_SIZE);
+        blockSize = applyEvents(offset, blockSize);
+        // Ramping parameters are updated at control rate; nothing to hear
+        // while silent, so ramps then advance a whole block at a time
+        if (smoother_.isActive() && !isSilent()) {
+            blockSize = std::min(blockSize, SMOOTHING_INTERVAL);
         }
+        renderBlock(leftOutput + offset, rightOutput + offset, blockSize);
+        offset += blockSize;
+    }
 
-        // Add more CC mappings as needed
-        default:
-            // Unhandled CC - ignore silently
-            break;
+    // Events still queued lie beyond this call; keep the clock running in
+    // case the next call comes without a new block timestamp
+    if (eventTiming_) {
+        blockTimestamp_ += static_cast<uint64_t>(numSamples * 1e9 / sampleRate_);
     }
 }
 
-void Synth::handleSustainPedal(bool sustain) {
-    // M16: Sustain pedal handling (CC #64)
-    performanceParams_.sustainPedal = sustain;
-
-    // Update all voices with new sustain state
-    for (int i = 0; i < NUM_VOICES; ++i) {
-        voices_[i].setSustained(sustain);
-    }
+bool Synth::isIdle() const {
+    // A ramp must finish before rendering stops, or it resumes from where it
+    // froze at the next note
+    return isSilent() && !smoother_.isActive();
+}
 
-    // When sustain is released, voices that were sustained will automatically
-    // release via the Voice::setSustained() method
+bool Synth::isSilent() const {
+    return !voices_.anyActive() && chorus_.isIdle() && events_.empty() && !patches_.pending();
 }
 
-void Synth::processStereo(Sample& leftOut, Sample& rightOut) {
-    // Update global LFO (shared by all voices)
-    float lfoValue = lfo_.process();
+void Synth::renderBlock(Sample* leftOutput, Sample* rightOutput, int numSamples) {
+    // Moving parameters take their value at the end of this block
+    if (smoother_.isActive()) {
+        smoother_.advance(numSamples, [this](ParamId id, float value) {
+            storeParam(paramDescriptor(id), value);
+        });
+    }
 
-    // M13: Scale LFO by modulation wheel (0.0 - 1.0)
-    float modulatedLfo = lfoValue * performanceParams_.modWheel;
+    // Parameter changes since the last block (before the idle check: a
+    // chorus mode change can end the chorus tail)
+    applyParameterChanges();
 
-    // Mix all voices
-    Sample mixedVoices = 0.0f;
+    // Nothing sounding and no chorus tail: skip LFO, voices and chorus
+    if (isSilent()) {
+        std::memset(leftOutput, 0, sizeof(Sample) * numSamples);
+        std::memset(rightOutput, 0, sizeof(Sample) * numSamples);
+        return;
+    }
 
-    for (int i = 0; i < NUM_VOICES; ++i) {
-        // Update voice with LFO value (scaled by mod wheel)
-        voices_[i].setLfoValue(modulatedLfo);
+    // Update global LFO (shared by all voices) for the whole block
+    lfo_.process(lfoBuffer_, numSamples);
+
+    // M13: Scale LFO by modulation wheel (0.0 - 1.0)
+    const float modWheel = patch_.performance.modWheel;
+    for (int i = 0; i < numSamples; ++i) {
+        lfoBuffer_[i] *= modWheel;
+    }
 
-        // Process and accumulate
-        mixedVoices += voices_[i].process();
+    // Shared noise block, only rendered when the noise source is in use
+    // (all voices share patch_.dco, so one check covers every voice)
+    const Sample* noise = nullptr;
+    if (patch_.dco.noiseLevel > 0.0f && voices_.anyActive()) {
+        for (int i = 0; i < numSamples; ++i) {
+            noiseBuffer_[i] = noise_.nextBipolar();
+        }
+        noise = noiseBuffer_;
     }
 
+    // Render and mix all active voices
+    voices_.process(lfoBuffer_, noise, mixBuffer_, numSamples);
+
     // Scale output to prevent clipping with multiple voices
     // Using 1/sqrt(NUM_VOICES) gives good headroom while maintaining loudness
     constexpr float voiceScale = 1.0f / 2.45f;  // sqrt(6) ≈ 2.45
-    mixedVoices *= voiceScale;
+    for (int i = 0; i < numSamples; ++i) {
+        mixBuffer_[i] *= voiceScale;
+    }
 
     // Process through chorus (converts mono to stereo)
-    chorus_.process(mixedVoices, leftOut, rightOut);
+    chorus_.process(mixBuffer_, leftOutput, rightOutput, numSamples);
+}
+
+void Synth::processStereo(Sample& leftOut, Sample& rightOut) {
+    renderEvents(&leftOut, &rightOut, 1);
 }
 
 Sample Synth::process() {
@@ -457,24 +569,51 @@ Sample Synth::process() {
 }
 
 void Synth::process(Sample* output, int numSamples) {
-    for (int i = 0; i < numSamples; ++i) {
-        output[i] = process();
+    int offset = 0;
+    while (offset < numSamples) {
+        int blockSize = std::min(numSamples - offset, MAX_BUFFER_SIZE);
+        renderEvents(scratchLeft_, scratchRight_, blockSize);
+
+        // Mix down to mono
+        for (int i = 0; i < blockSize; ++i) {
+            output[offset + i] = (scratchLeft_[i] + scratchRight_[i]) * 0.5f;
+        }
+        offset += blockSize;
     }
 }
 
 void Synth::processStereo(Sample* leftOutput, Sample* rightOutput, int numSamples) {
-    for (int i = 0; i < numSamples; ++i) {
-        processStereo(leftOutput[i], rightOutput[i]);
+    renderEvents(leftOutput, rightOutput, numSamples);
+}
+
+void Synth::processInterleaved(Sample* lr, int numFrames) {
+    // Render each block into the (cache-resident) scratch buffers and
+    // interleave straight into the caller's buffer, so drivers that want
+    // interleaved frames need no planar buffers of their own
+    int offset = 0;
+    while (offset < numFrames) {
+        int blockSize = std::min(numFrames - offset, MAX_BUFFER_SIZE);
+        renderEvents(scratchLeft_, scratchRight_, blockSize);
+
+        Sample* out = lr + offset * 2;
+        for (int i = 0; i < blockSize; ++i) {
+            out[i * 2] = scratchLeft_[i];
+            out[i * 2 + 1] = scratchRight_[i];
+        }
+        offset += blockSize;
     }
 }
 
 void Synth::reset() {
+    // Ramps jump to their targets
+    smoother_.advance(INT_MAX, [this](ParamId id, float value) {
+        storeParam(paramDescriptor(id), value);
+    });
+    applyParameterChanges();
+
     lfo_.reset();
     chorus_.reset();
-
-    for (int i = 0; i < NUM_VOICES; ++i) {
-        voices_[i].reset();
-    }
+    voices_.reset();
 }
 
 } // namespace phj
@@ -2,9 +2,14 @@
 
 #include "types.h"
 #include "parameters.h"
-#include "voice.h"
+#include "param_registry.h"
+#include "param_smoother.h"
+#include "patch_bank.h"
+#include "voice_bank.h"
 #include "lfo.h"
 #include "chorus.h"
+#include "event_queue.h"
+#include "triple_buffer.h"
 
 namespace phj {
 
@@ -13,12 +18,43 @@ namespace phj {
  *
  * Manages 6-voice polyphony, LFO, and global parameters.
  * M7: 6-voice polyphony with voice stealing
+ *
+ * Audio is rendered in blocks of up to MAX_BUFFER_SIZE samples: the LFO
+ * renders a control block, the VoiceBank renders and sums the active voices
+ * for the whole block, and the chorus processes the mix. While the engine
+ * is idle (see isIdle) blocks are filled with zeros without running any DSP.
+ *
+ * MIDI from another thread goes through postEvent(): events are queued in a
+ * wait-free SPSC ring and applied by the audio thread, so voice and
+ * parameter state is only touched by that thread. When the driver provides
+ * a block timestamp (setBlockTimestamp), each event is converted to a frame
+ * offset and rendering is split there, so notes land on the right sample;
+ * otherwise events apply at the start of the next block.
+ *
+ * Parameter setters only store the new values and mark the affected module
+ * dirty. Changes are applied once at the start of the next block, and only
+ * to that module on active voices; an idle voice keeps its dirty bits and
+ * picks up the current parameters at note-on. A knob sweep therefore costs
+ * one coefficient update per block instead of one per voice per message.
+ *
+ * Continuous parameters set through the registry (setParam, setParamValue,
+ * MIDI CCs) are ramped by a ParamSmoother instead of jumping. While a ramp
+ * is moving, blocks are split every SMOOTHING_INTERVAL samples and only the
+ * moving parameters are written; the struct setters apply immediately.
+ *
+ * A whole sound is a Patch. A control thread hands one over with postPatch()
+ * through a triple buffer; the audio thread swaps it in at the start of its
+ * next render call, ahead of any queued events, and never half-applied.
+ * MIDI Program Change instead goes through the event queue like a note, and
+ * the patch is looked up (setProgramLookup) when the audio thread reaches
+ * it, so it keeps its place among the notes around it.
  */
 class Synth {
 public:
     Synth();
 
     void setSampleRate(float sampleRate);
+    float getSampleRate() const { return sampleRate_; }
 
     // Parameter setting
     void setDcoParameters(const DcoParams& params);
@@ -29,6 +65,41 @@ public:
     void setChorusParameters(const ChorusParams& params);
     void setPerformanceParameters(const PerformanceParams& params);  // M11
 
+    // Whole sound at once. Pitch bend, mod wheel and sustain are the
+    // player's, not the patch's: setPatch keeps their current values.
+    void setPatch(const Patch& patch);
+    Patch getPatch() const;  // Ramping parameters at their targets
+
+    // Hand a patch over from the (single) control thread; the audio thread
+    // applies the latest one at the start of its next render call, before
+    // any queued events (queue a Program Change to keep event order)
+    void postPatch(const Patch& patch) { patches_.publish(patch); }
+
+    // Program Change source: the record for a program (0-127), or nullptr to
+    // ignore it. Called on the audio thread when a Program Change is applied,
+    // so it must not block or allocate. Set before rendering starts.
+    using ProgramLookup = const PatchRecord* (*)(int program, void* userData);
+    void setProgramLookup(ProgramLookup lookup, void* userData);
+
+    // Single parameters through the registry (param_registry.h): normalized
+    // 0-1 control values mapped by the parameter's curve, or plain units
+    // (clamped to the parameter's range). Invalid ids are ignored.
+    void setParam(ParamId id, float normalized);
+    void setParamValue(ParamId id, float value);
+    float getParamValue(ParamId id) const;  // Target value while ramping
+
+    // Ramp time for a continuous parameter (milliseconds, 0 = jump). Defaults
+    // to the descriptor's smoothingMs.
+    void setParamSmoothing(ParamId id, float ms) { smoother_.setTime(id, ms); }
+    float getParamSmoothing(ParamId id) const { return smoother_.getTime(id); }
+
+    // Filter cutoff control rate in samples (1 = per-sample, default FILTER_CONTROL_INTERVAL)
+    void setFilterControlInterval(int samples);
+
+    // Seed the voices' random generators (note-on phase, drift, noise) for
+    // reproducible renders
+    void setSeed(uint64_t seed);
+
     // MIDI handling
     void handleNoteOn(int midiNote, float velocity = 1.0f);
     void handleNoteOff(int midiNote);
@@ -38,39 +109,114 @@ public:
     void handleControlChange(int controller, int value);  // M16: Generic MIDI CC handler
     void handleSustainPedal(bool sustain);  // M16: Sustain pedal (CC #64)
 
+    // Decode and apply one channel message now (note on/off, CC, pitch bend,
+    // program change)
+    void handleMidiEvent(const MidiEvent& event);
+
+    // Queue an event from the (single) MIDI thread; it is applied by the audio
+    // thread at its timestamp (see setBlockTimestamp) or at the start of the
+    // next block. Returns false if the queue is full.
+    bool postEvent(const MidiEvent& event) { return events_.push(event); }
+
+    // Event-clock time (nanoseconds) of the first sample of the next render
+    // call. Queued events are rendered at their frame offset from this time;
+    // events stamped at or before it apply at the first sample. Drivers call
+    // this once per period with the start of the window the events arrived in.
+    void setBlockTimestamp(uint64_t timestamp);
+
     // Audio processing
     Sample process();  // Mono output (stereo mixed down)
     void process(Sample* output, int numSamples);
     void processStereo(Sample& leftOut, Sample& rightOut);  // Stereo output with chorus
     void processStereo(Sample* leftOutput, Sample* rightOutput, int numSamples);
+    void processInterleaved(Sample* lr, int numFrames);  // L, R, L, R, ... (2 * numFrames samples)
 
     // Reset all state
     void reset();
 
+    // True when no voice is sounding, the chorus tail has decayed, no events
+    // or patch are queued and no parameter is ramping: the output is silent
+    // until the next note, and drivers may skip rendering
+    bool isIdle() const;
+
 private:
     float sampleRate_;
 
     // Global LFO (shared by all voices)
     Lfo lfo_;
-    LfoParams lfoParams_;
 
-    // 6 voices for polyphony
-    Voice voices_[NUM_VOICES];
+    // 6 voices for polyphony (rendered lane-parallel)
+    VoiceBank voices_;
+
+    // Noise generator (one source shared by all voices, as on the Juno-106)
+    Random noise_;
 
     // Chorus effect
     Chorus chorus_;
-    ChorusParams chorusParams_;
 
     // Current parameters
-    DcoParams dcoParams_;
-    FilterParams filterParams_;
-    EnvelopeParams filterEnvParams_;
-    EnvelopeParams ampEnvParams_;
-    PerformanceParams performanceParams_;  // M11
+    Patch patch_;
+
+    // Patches from the control thread, picked up by the audio thread
+    TripleBuffer<Patch> patches_;
+
+    // Program Change -> bank record (nullptr: Program Change is ignored)
+    ProgramLookup programLookup_;
+    void* programUserData_;
+
+    // Ramps for registry writes (see ParamSmoother)
+    ParamSmoother smoother_;
+
+    // Events from the MIDI thread, drained by the audio thread
+    static constexpr int EVENT_QUEUE_SIZE = 256;
+    SpscQueue<MidiEvent, EVENT_QUEUE_SIZE> events_;
+    bool eventTiming_;         // Block timestamp set: place events by timestamp
+    uint64_t blockTimestamp_;  // Event-clock time of the next sample rendered
+
+    // Deferred parameter updates (see applyParameterChanges)
+    enum ParamGroup : uint8_t {
+        PARAM_DCO = 1 << 0,
+        PARAM_FILTER = 1 << 1,
+        PARAM_FILTER_ENV = 1 << 2,
+        PARAM_AMP_ENV = 1 << 3,
+        PARAM_PERFORMANCE = 1 << 4,  // Pitch bend, portamento, VCA, tune
+        PARAM_LFO = 1 << 5,
+        PARAM_CHORUS = 1 << 6,
+        VOICE_PARAMS = PARAM_DCO | PARAM_FILTER | PARAM_FILTER_ENV | PARAM_AMP_ENV | PARAM_PERFORMANCE
+    };
+    uint8_t dirty_;                    // LFO/chorus changes not yet applied
+    uint8_t voiceDirty_[NUM_VOICES];   // Voice modules not yet updated, per voice
+
+    // Silent output (isIdle() apart from ramps, which advance without sound)
+    bool isSilent() const;
+
+    void markDirty(uint8_t groups);
+    void writeParam(const ParamDescriptor& desc, float value);   // Ramped if smoothed
+    void storeParam(const ParamDescriptor& desc, float value);   // Immediate
+    void updateVoice(int index);       // Apply the voice's dirty modules
+    void applyParameterChanges();      // Globals, then active voices
+
+    // Block rendering scratch buffers (one control/audio block each)
+    float lfoBuffer_[MAX_BUFFER_SIZE];
+    Sample noiseBuffer_[MAX_BUFFER_SIZE];
+    Sample mixBuffer_[MAX_BUFFER_SIZE];
+    Sample scratchLeft_[MAX_BUFFER_SIZE];
+    Sample scratchRight_[MAX_BUFFER_SIZE];
 
     // Voice management helpers
     int findFreeVoice() const;
     int findVoiceToSteal() const;
+
+    // Apply events due at position (samples into the current render call) and
+    // return how many samples can be rendered before the next one (<= maxSamples)
+    int applyEvents(int position, int maxSamples);
+    int eventOffset(const MidiEvent& event) const;
+
+    // Render any number of samples, split at event offsets
+    void renderEvents(Sample* leftOutput, Sample* rightOutput, int numSamples);
+
+    // Render one block (numSamples <= MAX_BUFFER_SIZE): LFO + noise -> voices -> mix -> chorus
+    void renderBlock(Sample* leftOutput, Sample* rightOutput, int numSamples);
 };
 
 } // namespace phj
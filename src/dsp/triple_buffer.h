@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace phj {
+
+/**
+ * TripleBuffer - Wait-free latest-value handoff between two threads
+ *
+ * The writer fills a back slot and publishes it whole; the reader picks up
+ * the most recently published slot when it is ready (e.g. at a block
+ * boundary). Three slots mean neither side ever waits or sees a half-written
+ * value: the writer always has a free slot, the reader keeps its slot until
+ * it asks for a new one, and a value published twice before the reader looks
+ * simply replaces the first.
+ *
+ * One thread writes (write/publish), one reads (update/read). T is copied by
+ * value into preallocated slots, so neither side allocates.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : middle_(1), back_(2), front_(0) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Writer side: fill the back slot, then publish it
+    T& write() { return slots_[back_]; }
+
+    void publish() {
+        back_ = middle_.exchange(back_ | NEW_VALUE, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    void publish(const T& value) {
+        write() = value;
+        publish();
+    }
+
+    // Reader side: take the latest published value, if there is a new one.
+    // Returns false (and keeps the current slot) when nothing was published.
+    bool update() {
+        if ((middle_.load(std::memory_order_relaxed) & NEW_VALUE) == 0) {
+            return false;
+        }
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    const T& read() const { return slots_[front_]; }
+
+    // Either side (a snapshot; may be stale by the time it is used)
+    bool pending() const {
+        return (middle_.load(std::memory_order_acquire) & NEW_VALUE) != 0;
+    }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x03;
+    static constexpr uint8_t NEW_VALUE = 0x04;  // Middle slot not yet read
+
+    // Shared slot index (+ NEW_VALUE) apart from the side-owned indices
+    alignas(64) std::atomic<uint8_t> middle_;
+    alignas(64) uint8_t back_;   // Writer's slot
+    alignas(64) uint8_t front_;  // Reader's slot
+    T slots_[3];
+};
+
+} // namespace phj
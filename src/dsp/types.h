@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <cmath>
+#include "fast_math.h"
 
 namespace phj {
 
@@ -19,10 +20,13 @@ constexpr int MIDI_NOTE_ON = 0x90;
 constexpr int MIDI_NOTE_OFF = 0x80;
 constexpr int MIDI_CONTROL_CHANGE = 0xB0;
 constexpr int MIDI_CC = 0xB0;
+constexpr int MIDI_PROGRAM_CHANGE = 0xC0;
 constexpr int MIDI_PITCH_BEND = 0xE0;  // M11
 
 // Voice constants
 constexpr int NUM_VOICES = 6;
+constexpr int FILTER_CONTROL_INTERVAL = 16;  // Samples between filter cutoff updates
+constexpr int SMOOTHING_INTERVAL = 32;       // Samples between smoothed parameter updates
 
 // Utility functions
 inline float clamp(float value, float min, float max) {
@@ -33,7 +37,12 @@ inline float clamp(float value, float min, float max) {
 
 inline float midiNoteToFrequency(int note) {
     // A4 (MIDI note 69) = 440 Hz
-    return 440.0f * std::pow(2.0f, (note - 69) / 12.0f);
+    return 440.0f * semitonesToRatio(static_cast<float>(note - 69));
+}
+
+inline float midiNoteToFrequency(float note) {
+    // Fractional notes (e.g. mid-glide)
+    return 440.0f * semitonesToRatio(note - 69.0f);
 }
 
 inline float dbToLinear(float db) {
@@ -1,5 +1,6 @@
 #include "voice.h"
 #include <cmath>
+#include <cstring>
 
 namespace phj {
 
@@ -15,9 +16,11 @@ Voice::Voice()
     , pitchBendRange_(2.0f)
     , portamentoTime_(0.0f)
     , targetNote_(-1)
-    , currentFreq_(440.0f)
-    , targetFreq_(440.0f)
+    , currentPitch_(69.0f)
+    , targetPitch_(69.0f)
     , glideRate_(0.0f)
+    , pitchRatio_(1.0f)
+    , pitchDirty_(true)
     , vcaMode_(0)  // M13: Default to ENV mode
     , filterEnvPolarity_(0)  // M13: Default to Normal polarity
     , vcaLevel_(0.8f)  // M14: Default VCA level
@@ -29,6 +32,7 @@ Voice::Voice()
     filter_.setSampleRate(sampleRate_);
     filterEnv_.setSampleRate(sampleRate_);
     ampEnv_.setSampleRate(sampleRate_);
+    filter_.setCoefficientInterval(FILTER_CONTROL_INTERVAL);
 }
 
 void Voice::setSampleRate(float sampleRate) {
@@ -49,6 +53,22 @@ void Voice::setParameters(const DcoParams& dcoParams,
     ampEnv_.setParameters(ampEnvParams);
 }
 
+void Voice::setDcoParameters(const DcoParams& params) {
+    dco_.setParameters(params);
+}
+
+void Voice::setFilterParameters(const FilterParams& params) {
+    filter_.setParameters(params);
+}
+
+void Voice::setFilterEnvParameters(const EnvelopeParams& params) {
+    filterEnv_.setParameters(params);
+}
+
+void Voice::setAmpEnvParameters(const EnvelopeParams& params) {
+    ampEnv_.setParameters(params);
+}
+
 void Voice::noteOn(int midiNote, float velocity) {
     currentNote_ = midiNote;
     velocity_ = clamp(velocity, 0.0f, 1.0f);
@@ -57,21 +77,22 @@ void Voice::noteOn(int midiNote, float velocity) {
 
     // M11: Setup portamento (glide)
     targetNote_ = midiNote;
-    targetFreq_ = midiNoteToFrequency(midiNote);
+    targetPitch_ = static_cast<float>(midiNote);
 
     // If portamento is enabled and this is a legato note (voice was already active)
     if (portamentoTime_ > 0.0f && isActive()) {
-        // Start gliding from current frequency to target
+        // Start gliding from current pitch to target (constant semitones/second)
         float glideTimeSamples = portamentoTime_ * sampleRate_;
-        glideRate_ = (targetFreq_ - currentFreq_) / glideTimeSamples;
+        glideRate_ = (targetPitch_ - currentPitch_) / glideTimeSamples;
     } else {
         // No glide - jump immediately to target
-        currentFreq_ = targetFreq_;
+        currentPitch_ = targetPitch_;
         glideRate_ = 0.0f;
     }
+    pitchDirty_ = true;
 
     // Set frequency for filter (use target for filter tracking)
-    filter_.setNoteFrequency(targetFreq_);
+    filter_.setNoteFrequency(midiNoteToFrequency(midiNote));
 
     // Trigger envelopes and oscillator
     dco_.noteOn();
@@ -102,9 +123,10 @@ void Voice::reset() {
     lfoValue_ = 0.0f;
     pitchBend_ = 0.0f;
     targetNote_ = -1;
-    currentFreq_ = 440.0f;
-    targetFreq_ = 440.0f;
+    currentPitch_ = 69.0f;
+    targetPitch_ = 69.0f;
     glideRate_ = 0.0f;
+    updatePitchRatio();
 
     dco_.reset();
     filter_.reset();
@@ -121,6 +143,7 @@ void Voice::setLfoValue(float lfoValue) {
 void Voice::setPitchBend(float pitchBend, float pitchBendRange) {
     pitchBend_ = clamp(pitchBend, -1.0f, 1.0f);
     pitchBendRange_ = pitchBendRange;
+    updatePitchRatio();
 }
 
 void Voice::setPortamentoTime(float portamentoTime) {
@@ -151,6 +174,22 @@ void Voice::setVelocitySensitivity(float filterAmount, float ampAmount) {
 void Voice::setMasterTune(float cents) {
     // M14: Set master tune (±50 cents)
     masterTune_ = clamp(cents, -50.0f, 50.0f);
+    updatePitchRatio();
+}
+
+void Voice::updatePitchRatio() {
+    // M11 + M14: Pitch bend (semitones) and master tune (cents) as one ratio
+    float semitones = pitchBend_ * pitchBendRange_ + masterTune_ * 0.01f;
+    pitchRatio_ = semitonesToRatio(semitones);
+    pitchDirty_ = true;
+}
+
+void Voice::setFilterControlInterval(int samples) {
+    filter_.setCoefficientInterval(samples);
+}
+
+void Voice::setSeed(uint64_t seed, uint64_t stream) {
+    dco_.setSeed(seed, stream);
 }
 
 void Voice::setSustained(bool sustained) {
@@ -171,23 +210,30 @@ Sample Voice::process() {
         return 0.0f;
     }
 
-    // Update voice age
-    age_ += 1.0f;
+    float cutoffCoeff, resonanceCoeff, vcaGain;
+    Sample filterInput = processFrontEnd(nullptr, cutoffCoeff, resonanceCoeff, vcaGain);
 
-    // M11: Update portamento glide
-    updateGlide();
+    // Process through the filter ladder
+    Sample filtered = filter_.processLadder(filterInput);
 
-    // M11: Calculate final frequency with pitch bend
-    float pitchBendSemitones = pitchBend_ * pitchBendRange_;
-    float pitchBendRatio = std::pow(2.0f, pitchBendSemitones / 12.0f);
+    return filtered * vcaGain;
+}
 
-    // M14: Apply master tune (in cents)
-    float masterTuneRatio = std::pow(2.0f, masterTune_ / 1200.0f);
+Sample Voice::processFrontEnd(const Sample* noise, float& cutoffCoeff, float& resonanceCoeff, float& vcaGain) {
+    // Update voice age
+    age_ += 1.0f;
 
-    float finalFreq = currentFreq_ * pitchBendRatio * masterTuneRatio;
+    // M11: Portamento is the only audio-rate pitch source
+    if (glideRate_ != 0.0f) {
+        updateGlide();
+        pitchDirty_ = true;
+    }
 
-    // Update DCO frequency
-    dco_.setFrequency(finalFreq);
+    // Update DCO frequency only when the pitch actually changed
+    if (pitchDirty_) {
+        dco_.setFrequency(midiNoteToFrequency(currentPitch_) * pitchRatio_);
+        pitchDirty_ = false;
+    }
 
     // Process envelopes
     float filterEnvValue = filterEnv_.process();
@@ -206,27 +252,29 @@ Sample Voice::process() {
     filter_.setVelocityValue(velocity_, velocityToFilter_);
 
     // Generate oscillator output
-    Sample dcoOut = dco_.process();
+    Sample dcoOut = noise ? dco_.process(*noise) : dco_.process();
 
-    // Process through filter
-    Sample filtered = filter_.process(dcoOut);
+    // Filter input stage (coefficients, HPF, drive)
+    Sample filterInput = filter_.processInput(dcoOut);
+    cutoffCoeff = filter_.getCutoffCoefficient();
+    resonanceCoeff = filter_.getResonanceCoefficient();
 
     // M13: Apply VCA mode (ENV or GATE)
-    float vcaGain;
+    float modeGain;
     if (vcaMode_ == 1) {  // GATE mode: instant on/off
-        vcaGain = noteActive_ ? 1.0f : 0.0f;
+        modeGain = noteActive_ ? 1.0f : 0.0f;
     } else {  // ENV mode (default): use amplitude envelope
-        vcaGain = ampEnvValue;
+        modeGain = ampEnvValue;
     }
 
     // M14: Apply velocity to amplitude (scaled by velocityToAmp)
     // velocity ranges from 0-1, so we lerp between no effect (1.0) and full effect (velocity)
     float velocityGain = 1.0f - velocityToAmp_ + (velocityToAmp_ * velocity_);
 
-    // M14: Apply VCA level, VCA gain, and velocity
-    Sample output = filtered * vcaLevel_ * vcaGain * velocityGain;
+    // M14: Combine VCA level, VCA gain, and velocity
+    vcaGain = vcaLevel_ * modeGain * velocityGain;
 
-    return output;
+    return filterInput;
 }
 
 void Voice::process(Sample* output, int numSamples) {
@@ -235,6 +283,19 @@ void Voice::process(Sample* output, int numSamples) {
     }
 }
 
+void Voice::process(const float* lfoInput, Sample* output, int numSamples) {
+    // Idle voices render nothing - skip the whole block
+    if (!isActive()) {
+        std::memset(output, 0, sizeof(Sample) * numSamples);
+        return;
+    }
+
+    for (int i = 0; i < numSamples; ++i) {
+        setLfoValue(lfoInput[i]);
+        output[i] = process();
+    }
+}
+
 bool Voice::isActive() const {
     // Voice is active if either envelope is active
     return filterEnv_.isActive() || ampEnv_.isActive();
@@ -246,16 +307,14 @@ bool Voice::isReleasing() const {
 }
 
 void Voice::updateGlide() {
-    // M11: Update portamento glide
-    if (glideRate_ != 0.0f) {
-        // Check if we've reached the target
-        if ((glideRate_ > 0.0f && currentFreq_ >= targetFreq_) ||
-            (glideRate_ < 0.0f && currentFreq_ <= targetFreq_)) {
-            currentFreq_ = targetFreq_;
-            glideRate_ = 0.0f;
-        } else {
-            currentFreq_ += glideRate_;
-        }
+    // M11: Update portamento glide (linear in pitch = exponential in frequency)
+    currentPitch_ += glideRate_;
+
+    // Check if we've reached the target
+    if ((glideRate_ > 0.0f && currentPitch_ >= targetPitch_) ||
+        (glideRate_ < 0.0f && currentPitch_ <= targetPitch_)) {
+        currentPitch_ = targetPitch_;
+        glideRate_ = 0.0f;
     }
 }
 
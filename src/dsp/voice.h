@@ -25,6 +25,12 @@ public:
                       const EnvelopeParams& filterEnvParams,
                       const EnvelopeParams& ampEnvParams);
 
+    // Per-module updates (Filter and Envelope recompute their coefficients)
+    void setDcoParameters(const DcoParams& params);
+    void setFilterParameters(const FilterParams& params);
+    void setFilterEnvParameters(const EnvelopeParams& params);
+    void setAmpEnvParameters(const EnvelopeParams& params);
+
     // Voice control
     void noteOn(int midiNote, float velocity = 1.0f);
     void noteOff();
@@ -46,6 +52,12 @@ public:
     void setVelocitySensitivity(float filterAmount, float ampAmount);  // 0.0 - 1.0
     void setMasterTune(float cents);  // ±50 cents
 
+    // Filter cutoff control rate in samples (1 = per-sample)
+    void setFilterControlInterval(int samples);
+
+    // Seed the DCO's random generator (note-on phase, drift, noise)
+    void setSeed(uint64_t seed, uint64_t stream = 0);
+
     // M16: Sustain pedal support
     void setSustained(bool sustained);  // Mark voice as sustained
     bool isSustained() const { return sustained_; }
@@ -56,6 +68,16 @@ public:
     // Process buffer
     void process(Sample* output, int numSamples);
 
+    // Process buffer with a per-sample LFO control block (from the shared LFO)
+    void process(const float* lfoInput, Sample* output, int numSamples);
+
+    // Lane-parallel rendering support (see VoiceBank): renders one sample of
+    // everything ahead of the ladder filter and returns the filter input,
+    // plus the ladder coefficients and the total VCA gain for that sample.
+    // noise points at the shared noise sample, or is null to let the DCO
+    // generate its own.
+    Sample processFrontEnd(const Sample* noise, float& cutoffCoeff, float& resonanceCoeff, float& vcaGain);
+
     // Voice state queries
     bool isActive() const;
     bool isReleasing() const;
@@ -83,12 +105,17 @@ private:
     float pitchBend_;       // -1.0 to 1.0
     float pitchBendRange_;  // Semitones
 
-    // M11: Portamento state
+    // M11: Portamento state (log domain: pitch in semitones / MIDI note units)
     float portamentoTime_;  // Seconds
     int targetNote_;        // Target MIDI note for glide
-    float currentFreq_;     // Current frequency (with glide)
-    float targetFreq_;      // Target frequency
-    float glideRate_;       // Frequency change per sample
+    float currentPitch_;    // Current pitch (with glide)
+    float targetPitch_;     // Target pitch
+    float glideRate_;       // Pitch change per sample (semitones)
+
+    // Pitch pipeline: event-rate pitch offsets are folded into one cached
+    // ratio, so only the glide needs per-sample work
+    float pitchRatio_;      // Pitch bend x master tune
+    bool pitchDirty_;       // DCO frequency needs recomputing
 
     // M13: Performance control state
     int vcaMode_;           // 0=ENV, 1=GATE
@@ -101,6 +128,7 @@ private:
     float masterTune_;          // Master tune in cents (±50)
 
     void updateGlide();     // M11: Update portamento glide
+    void updatePitchRatio();
 };
 
 } // namespace phj
@@ -0,0 +1,125 @@
+#include "voice_bank.h"
+#include "filter.h"
+#include <algorithm>
+#include <cstring>
+
+namespace phj {
+
+VoiceBank::VoiceBank() {
+    std::memset(laneInput_, 0, sizeof(laneInput_));
+    std::memset(laneG_, 0, sizeof(laneG_));
+    std::memset(laneK_, 0, sizeof(laneK_));
+    std::memset(laneGain_, 0, sizeof(laneGain_));
+
+    for (int lane = 0; lane < NUM_LANES; ++lane) {
+        clearLane(lane);
+    }
+
+    setSeed(Random::DEFAULT_SEED);
+}
+
+void VoiceBank::setSampleRate(float sampleRate) {
+    for (int i = 0; i < NUM_VOICES; ++i) {
+        voices_[i].setSampleRate(sampleRate);
+    }
+}
+
+void VoiceBank::setSeed(uint64_t seed) {
+    for (int i = 0; i < NUM_VOICES; ++i) {
+        voices_[i].setSeed(seed, static_cast<uint64_t>(i));
+    }
+}
+
+void VoiceBank::noteOn(int voiceIndex, int midiNote, float velocity) {
+    voices_[voiceIndex].noteOn(midiNote, velocity);
+
+    // Clear ladder state to prevent artifacts (matches Voice::noteOn filter reset)
+    clearLane(voiceIndex);
+}
+
+bool VoiceBank::anyActive() const {
+    for (int i = 0; i < NUM_VOICES; ++i) {
+        if (voices_[i].isActive()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void VoiceBank::reset() {
+    for (int i = 0; i < NUM_VOICES; ++i) {
+        voices_[i].reset();
+    }
+    for (int lane = 0; lane < NUM_LANES; ++lane) {
+        clearLane(lane);
+    }
+}
+
+void VoiceBank::clearLane(int lane) {
+    stage1_[lane] = 0.0f;
+    stage2_[lane] = 0.0f;
+    stage3_[lane] = 0.0f;
+    stage4_[lane] = 0.0f;
+}
+
+void VoiceBank::process(const float* lfoInput, const Sample* noiseInput, Sample* output, int numSamples) {
+    // Nothing playing - skip the lanes entirely
+    if (!anyActive()) {
+        std::memset(output, 0, sizeof(Sample) * numSamples);
+        return;
+    }
+
+    int offset = 0;
+    while (offset < numSamples) {
+        int blockSize = std::min(numSamples - offset, SUB_BLOCK_SIZE);
+        processSubBlock(lfoInput + offset, noiseInput ? noiseInput + offset : nullptr,
+                        output + offset, blockSize);
+        offset += blockSize;
+    }
+}
+
+void VoiceBank::processSubBlock(const float* lfoInput, const Sample* noiseInput, Sample* output, int numSamples) {
+    // Front end (per voice): envelopes, DCO, filter modulation and input stage.
+    // Idle voices feed silence into their lane, which leaves the lane state untouched.
+    for (int v = 0; v < NUM_VOICES; ++v) {
+        Voice& voice = voices_[v];
+
+        for (int i = 0; i < numSamples; ++i) {
+            if (!voice.isActive()) {
+                laneInput_[i][v] = 0.0f;
+                laneG_[i][v] = 0.0f;
+                laneK_[i][v] = 0.0f;
+                laneGain_[i][v] = 0.0f;
+                continue;
+            }
+
+            voice.setLfoValue(lfoInput[i]);
+            laneInput_[i][v] = voice.processFrontEnd(noiseInput ? noiseInput + i : nullptr,
+                                                     laneG_[i][v], laneK_[i][v], laneGain_[i][v]);
+        }
+    }
+
+    // Ladder filter and VCA for all lanes at once, then sum the voices
+    alignas(32) float laneOut[NUM_LANES];
+
+    for (int i = 0; i < numSamples; ++i) {
+        const float* input = laneInput_[i];
+        const float* g = laneG_[i];
+        const float* k = laneK_[i];
+        const float* gain = laneGain_[i];
+
+        for (int lane = 0; lane < NUM_LANES; ++lane) {
+            laneOut[lane] = Filter::ladderTick(input[lane], g[lane], k[lane],
+                                               stage1_[lane], stage2_[lane],
+                                               stage3_[lane], stage4_[lane]) * gain[lane];
+        }
+
+        Sample sum = 0.0f;
+        for (int lane = 0; lane < NUM_LANES; ++lane) {
+            sum += laneOut[lane];
+        }
+        output[i] = sum;
+    }
+}
+
+} // namespace phj
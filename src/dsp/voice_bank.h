@@ -0,0 +1,70 @@
+#pragma once
+
+#include "types.h"
+#include "parameters.h"
+#include "voice.h"
+
+namespace phj {
+
+/**
+ * VoiceBank - Lane-parallel voice renderer
+ *
+ * Owns the synth's voices and renders them together. Each voice keeps its
+ * control logic (note state, envelopes, DCO, filter modulation) and renders
+ * the front end of its chain one sample at a time. The per-sample ladder
+ * filter, VCA and voice summing then run in structure-of-arrays form with
+ * one lane per voice, so the inner loops over lanes vectorize (NEON on the
+ * Pi, SSE/AVX on x86) without any intrinsics in the DSP core.
+ *
+ * NUM_LANES is NUM_VOICES rounded up to a multiple of 4; padding lanes are
+ * fed silence. Raising NUM_VOICES only widens the lane arrays.
+ */
+class VoiceBank {
+public:
+    static constexpr int NUM_LANES = (NUM_VOICES + 3) & ~3;
+
+    VoiceBank();
+
+    void setSampleRate(float sampleRate);
+
+    // Seed every voice from one value; each voice uses its own stream, so
+    // voices stay decorrelated while renders are reproducible
+    void setSeed(uint64_t seed);
+
+    // Voice access (note state, parameters, queries)
+    Voice& operator[](int index) { return voices_[index]; }
+    const Voice& operator[](int index) const { return voices_[index]; }
+
+    // Trigger a voice and clear its ladder lane
+    void noteOn(int voiceIndex, int midiNote, float velocity);
+
+    // Render all active voices and write their sum to output. noiseInput is
+    // a shared white noise block read by every voice, or null to let each
+    // DCO generate its own noise.
+    void process(const float* lfoInput, const Sample* noiseInput, Sample* output, int numSamples);
+
+    bool anyActive() const;
+    void reset();
+
+private:
+    Voice voices_[NUM_VOICES];
+
+    // Lane work buffers are filled in sub-blocks to stay in L1 cache
+    static constexpr int SUB_BLOCK_SIZE = 32;
+
+    alignas(32) float laneInput_[SUB_BLOCK_SIZE][NUM_LANES];  // Ladder input
+    alignas(32) float laneG_[SUB_BLOCK_SIZE][NUM_LANES];      // Cutoff coefficient
+    alignas(32) float laneK_[SUB_BLOCK_SIZE][NUM_LANES];      // Resonance coefficient
+    alignas(32) float laneGain_[SUB_BLOCK_SIZE][NUM_LANES];   // VCA gain
+
+    // ZDF ladder stage state, one lane per voice
+    alignas(32) float stage1_[NUM_LANES];
+    alignas(32) float stage2_[NUM_LANES];
+    alignas(32) float stage3_[NUM_LANES];
+    alignas(32) float stage4_[NUM_LANES];
+
+    void clearLane(int lane);
+    void processSubBlock(const float* lfoInput, const Sample* noiseInput, Sample* output, int numSamples);
+};
+
+} // namespace phj
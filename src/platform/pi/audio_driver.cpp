@@ -1,8 +1,10 @@
 #include "audio_driver.h"
+#include "sample_convert.h"
 #include <iostream>
 #include <cstring>
 #include <sched.h>
 #include <cstdint>
+#include <cerrno>
 
 // Enable denormal flushing to prevent CPU slowdown
 #if defined(__x86_64__) || defined(__i386__)
@@ -15,13 +17,19 @@ namespace phj {
 AudioDriver::AudioDriver()
     : handle_(nullptr)
     , callback_(nullptr)
+    , idleCallback_(nullptr)
     , callbackUserData_(nullptr)
     , sampleRate_(0)
     , bufferSize_(0)
     , running_(false)
     , format_(SND_PCM_FORMAT_UNKNOWN)
-    , interleavedBuffer_(nullptr)
+    , mmap_(false)
     , hwBuffer_(nullptr)
+    , hwBufferSilent_(false)
+    , renderBuffer_(nullptr)
+    , frameBytes_(0)
+    , dither_(false)
+    , log_("audio")
     , audioThread_(0)
 {
 }
@@ -52,8 +60,14 @@ bool AudioDriver::initialize(const std::string& deviceName, unsigned int sampleR
         return false;
     }
 
-    // Set parameters with error checking
-    err = snd_pcm_hw_params_set_access(handle_, params, SND_PCM_ACCESS_RW_INTERLEAVED);
+    // Prefer mmap access: the audio thread then writes converted samples
+    // straight into the DMA buffer instead of a period buffer that
+    // snd_pcm_writei copies again. Fall back to RW if the device can't mmap.
+    err = snd_pcm_hw_params_set_access(handle_, params, SND_PCM_ACCESS_MMAP_INTERLEAVED);
+    mmap_ = err >= 0;
+    if (!mmap_) {
+        err = snd_pcm_hw_params_set_access(handle_, params, SND_PCM_ACCESS_RW_INTERLEAVED);
+    }
     if (err < 0) {
         std::cerr << "Cannot set access type: " << snd_strerror(err) << std::endl;
         snd_pcm_close(handle_);
@@ -177,22 +191,26 @@ bool AudioDriver::initialize(const std::string& deviceName, unsigned int sampleR
         return false;
     }
 
-    // Allocate interleaved buffer (always float for DSP processing)
-    interleavedBuffer_ = new float[bufferSize_ * 2];  // Stereo
+    frameBytes_ = 2 * snd_pcm_format_physical_width(format_) / 8;
 
-    // Allocate hardware buffer if format conversion needed
-    if (format_ == SND_PCM_FORMAT_S16_LE) {
-        hwBuffer_ = new int16_t[bufferSize_ * 2];  // 16-bit stereo
-    } else if (format_ == SND_PCM_FORMAT_S32_LE) {
-        hwBuffer_ = new int32_t[bufferSize_ * 2];  // 32-bit stereo
-    } else {
-        hwBuffer_ = nullptr;  // FLOAT_LE - no conversion needed
+    // RW access needs a period buffer in hardware format for snd_pcm_writei;
+    // with mmap the samples go straight into the DMA area
+    if (!mmap_) {
+        hwBuffer_ = new uint8_t[bufferSize_ * frameBytes_];
+        hwBufferSilent_ = false;
     }
 
+    // Float period for integer formats (converted from here) and for mmap
+    // windows split at the buffer wrap
+    renderBuffer_ = new float[bufferSize_ * 2];
+
     float latencyMs = (float)bufferSize_ / sampleRate_ * 1000.0f;
     float totalLatencyMs = (float)bufferSizeFrames / sampleRate_ * 1000.0f;
-    std::cout << "Audio initialized: " << sampleRate_ << " Hz" << std::endl;
+    std::cout << "Audio initialized: " << sampleRate_ << " Hz ("
+              << (mmap_ ? "mmap" : "read/write") << " access)" << std::endl;
     std::cout << "  Period size: " << bufferSize_ << " samples (" << latencyMs << " ms)" << std::endl;
+    std::cout << "  Sample conversion: " << sampleconv::kernelName()
+              << (dither_ && format_ == SND_PCM_FORMAT_S16_LE ? " (TPDF dither)" : "") << std::endl;
     std::cout << "  Buffer size: " << bufferSizeFrames << " samples (" << totalLatencyMs << " ms)" << std::endl;
 
     return true;
@@ -201,20 +219,16 @@ bool AudioDriver::initialize(const std::string& deviceName, unsigned int sampleR
 void AudioDriver::shutdown() {
     stop();
 
-    if (interleavedBuffer_) {
-        delete[] interleavedBuffer_;
-        interleavedBuffer_ = nullptr;
-    }
-
     if (hwBuffer_) {
-        if (format_ == SND_PCM_FORMAT_S16_LE) {
-            delete[] static_cast<int16_t*>(hwBuffer_);
-        } else if (format_ == SND_PCM_FORMAT_S32_LE) {
-            delete[] static_cast<int32_t*>(hwBuffer_);
-        }
+        delete[] static_cast<uint8_t*>(hwBuffer_);
         hwBuffer_ = nullptr;
     }
 
+    if (renderBuffer_) {
+        delete[] renderBuffer_;
+        renderBuffer_ = nullptr;
+    }
+
     if (handle_) {
         snd_pcm_close(handle_);
         handle_ = nullptr;
@@ -226,6 +240,10 @@ void AudioDriver::setCallback(AudioCallback callback, void* userData) {
     callbackUserData_ = userData;
 }
 
+void AudioDriver::setIdleCallback(IdleCallback callback) {
+    idleCallback_ = callback;
+}
+
 bool AudioDriver::start() {
     if (running_ || !handle_ || !callback_) {
         return false;
@@ -267,10 +285,10 @@ void* AudioDriver::audioThreadFunc(void* arg) {
     param.sched_priority = 80;  // High priority (1-99, higher is more important)
     int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
     if (result != 0) {
-        std::cerr << "Warning: Could not set real-time priority for audio thread (run as root or adjust system limits)" << std::endl;
+        driver->log_.log(LogLevel::Warning, "Could not set real-time priority for audio thread (run as root or adjust system limits)");
         // Continue anyway - will run at normal priority
     } else {
-        std::cout << "Audio thread running at real-time priority (SCHED_FIFO, priority 80)" << std::endl;
+        driver->log_.log(LogLevel::Info, "Audio thread running at real-time priority (SCHED_FIFO, priority 80)");
     }
 
     driver->runAudioLoop();
@@ -296,67 +314,133 @@ void AudioDriver::runAudioLoop() {
     __asm__ __volatile__("vmsr fpscr, %0" :: "r"(fpscr | (1 << 24)));  // Set FZ bit
 #endif
 
-    float* leftBuffer = new float[bufferSize_];
-    float* rightBuffer = new float[bufferSize_];
-
     while (running_) {
-        // Call user callback to fill buffers
-        callback_(leftBuffer, rightBuffer, bufferSize_, callbackUserData_);
-
-        // Interleave samples (LRLRLR...)
-        for (unsigned int i = 0; i < bufferSize_; ++i) {
-            interleavedBuffer_[i * 2] = leftBuffer[i];
-            interleavedBuffer_[i * 2 + 1] = rightBuffer[i];
+        // Idle engine: skip DSP and conversion, just keep the device fed
+        bool idle = idleCallback_ && idleCallback_(callbackUserData_);
+        bool ok = mmap_ ? writePeriodMmap(idle) : writePeriodRw(idle);
+        if (!ok) {
+            break;
         }
+    }
+}
 
-        // Convert to hardware format if needed
-        void* writeBuffer;
-        if (format_ == SND_PCM_FORMAT_S16_LE) {
-            // Convert float (-1.0 to 1.0) to 16-bit signed integer (-32768 to 32767)
-            int16_t* s16Buffer = static_cast<int16_t*>(hwBuffer_);
-            for (unsigned int i = 0; i < bufferSize_ * 2; ++i) {
-                float sample = interleavedBuffer_[i];
-                // Clamp to valid range
-                if (sample > 1.0f) sample = 1.0f;
-                if (sample < -1.0f) sample = -1.0f;
-                s16Buffer[i] = static_cast<int16_t>(sample * 32767.0f);
-            }
-            writeBuffer = hwBuffer_;
-        } else if (format_ == SND_PCM_FORMAT_S32_LE) {
-            // Convert float (-1.0 to 1.0) to 32-bit signed integer
-            int32_t* s32Buffer = static_cast<int32_t*>(hwBuffer_);
-            for (unsigned int i = 0; i < bufferSize_ * 2; ++i) {
-                float sample = interleavedBuffer_[i];
-                // Clamp to valid range
-                if (sample > 1.0f) sample = 1.0f;
-                if (sample < -1.0f) sample = -1.0f;
-                s32Buffer[i] = static_cast<int32_t>(sample * 2147483647.0f);
-            }
-            writeBuffer = hwBuffer_;
+void AudioDriver::renderPeriod(void* dst) {
+    if (format_ == SND_PCM_FORMAT_FLOAT_LE) {
+        // The synth renders interleaved frames straight into the output
+        callback_(static_cast<float*>(dst), bufferSize_, callbackUserData_);
+        return;
+    }
+    callback_(renderBuffer_, bufferSize_, callbackUserData_);
+    convertSamples(dst, renderBuffer_, bufferSize_);
+}
+
+void AudioDriver::convertSamples(void* dst, const float* src, unsigned int frames) {
+    int count = static_cast<int>(frames * 2);
+    if (format_ == SND_PCM_FORMAT_S16_LE) {
+        if (dither_) {
+            sampleconv::floatToS16Dithered(src, static_cast<int16_t*>(dst), count, ditherRng_);
         } else {
-            // FLOAT_LE - no conversion needed
-            writeBuffer = interleavedBuffer_;
+            sampleconv::floatToS16(src, static_cast<int16_t*>(dst), count);
         }
+    } else if (format_ == SND_PCM_FORMAT_S32_LE) {
+        sampleconv::floatToS32(src, static_cast<int32_t*>(dst), count);
+    } else {
+        std::memcpy(dst, src, frames * frameBytes_);
+    }
+}
+
+bool AudioDriver::writePeriodRw(bool silent) {
+    // Render into the period buffer (a period of silence - all-zero bits in
+    // every supported format - is only written once per idle stretch)
+    if (!silent) {
+        renderPeriod(hwBuffer_);
+        hwBufferSilent_ = false;
+    } else if (!hwBufferSilent_) {
+        std::memset(hwBuffer_, 0, bufferSize_ * frameBytes_);
+        hwBufferSilent_ = true;
+    }
+
+    snd_pcm_sframes_t frames = snd_pcm_writei(handle_, hwBuffer_, bufferSize_);
+    if (frames < 0) {
+        return recover(static_cast<int>(frames));
+    }
+    if (frames < (snd_pcm_sframes_t)bufferSize_) {
+        log_.log(LogLevel::Warning, "Short write (expected %u, wrote %ld)", bufferSize_, static_cast<long>(frames));
+    }
+    return true;
+}
 
-        // Write to ALSA
-        snd_pcm_sframes_t frames = snd_pcm_writei(handle_, writeBuffer, bufferSize_);
+bool AudioDriver::writePeriodMmap(bool silent) {
+    snd_pcm_uframes_t written = 0;
+    bool rendered = false;  // renderBuffer_ holds this period
+    while (written < bufferSize_ && running_) {
+        snd_pcm_uframes_t remaining = bufferSize_ - written;
 
-        if (frames < 0) {
-            frames = snd_pcm_recover(handle_, frames, 0);
+        snd_pcm_sframes_t avail = snd_pcm_avail_update(handle_);
+        if (avail < 0) {
+            if (!recover(static_cast<int>(avail))) return false;
+            continue;
         }
 
-        if (frames < 0) {
-            std::cerr << "snd_pcm_writei failed: " << snd_strerror(frames) << std::endl;
-            break;
+        if (static_cast<snd_pcm_uframes_t>(avail) < remaining) {
+            // Buffer full. After (re)preparing, that is the moment to start
+            // playback; while running, sleep until a period has been played.
+            if (snd_pcm_state(handle_) == SND_PCM_STATE_PREPARED) {
+                int err = snd_pcm_start(handle_);
+                if (err < 0 && !recover(err)) return false;
+            } else {
+                int err = snd_pcm_wait(handle_, 1000);
+                if (err < 0 && !recover(err)) return false;
+            }
+            continue;
+        }
+
+        // The mapped window can end at the buffer wrap: then take two steps
+        const snd_pcm_channel_area_t* areas;
+        snd_pcm_uframes_t offset;
+        snd_pcm_uframes_t frames = remaining;
+        int err = snd_pcm_mmap_begin(handle_, &areas, &offset, &frames);
+        if (err < 0) {
+            if (!recover(err)) return false;
+            continue;
+        }
+
+        // Interleaved access: one area, frames are areas[0].step bits apart
+        uint8_t* dst = static_cast<uint8_t*>(areas[0].addr) + (areas[0].first + offset * areas[0].step) / 8;
+        if (silent) {
+            std::memset(dst, 0, frames * frameBytes_);
+        } else if (frames == bufferSize_) {
+            // Whole period in one window (the usual case): render in place
+            renderPeriod(dst);
+        } else {
+            if (!rendered) {
+                callback_(renderBuffer_, bufferSize_, callbackUserData_);
+                rendered = true;
+            }
+            convertSamples(dst, renderBuffer_ + written * 2, static_cast<unsigned int>(frames));
         }
 
-        if (frames > 0 && frames < (snd_pcm_sframes_t)bufferSize_) {
-            std::cerr << "Short write (expected " << bufferSize_ << ", wrote " << frames << ")" << std::endl;
+        snd_pcm_sframes_t committed = snd_pcm_mmap_commit(handle_, offset, frames);
+        if (committed < 0 || static_cast<snd_pcm_uframes_t>(committed) != frames) {
+            if (!recover(committed < 0 ? static_cast<int>(committed) : -EPIPE)) return false;
+            continue;
         }
+        written += frames;
     }
+    return true;
+}
 
-    delete[] leftBuffer;
-    delete[] rightBuffer;
+bool AudioDriver::recover(int err) {
+    // Recover silently here and report through the log
+    if (err == -EPIPE) {
+        log_.log(LogLevel::Warning, "Underrun: %s", snd_strerror(err));
+    }
+    err = snd_pcm_recover(handle_, err, 1);
+    if (err < 0) {
+        log_.log(LogLevel::Error, "ALSA output failed: %s", snd_strerror(err));
+        return false;
+    }
+    return true;
 }
 
 } // namespace phj
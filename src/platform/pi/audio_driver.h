@@ -3,6 +3,8 @@
 #include <alsa/asoundlib.h>
 #include <string>
 #include "../../dsp/types.h"
+#include "../../dsp/random.h"
+#include "rt_log.h"
 
 namespace phj {
 
@@ -14,20 +16,33 @@ public:
     bool initialize(const std::string& deviceName, unsigned int sampleRate, unsigned int bufferSize);
     void shutdown();
 
-    // Audio callback - called by ALSA when buffer needs filling
-    using AudioCallback = void(*)(float* left, float* right, int numSamples, void* userData);
+    // Audio callback - fills numFrames interleaved stereo frames (L, R, L, R, ...).
+    // For FLOAT_LE devices the buffer can be the device's mmap area itself.
+    using AudioCallback = void(*)(float* interleaved, int numFrames, void* userData);
     void setCallback(AudioCallback callback, void* userData);
 
+    // Idle query - called once per period before the audio callback (same
+    // userData). While it returns true the audio thread skips the callback
+    // and format conversion and writes silence, so an idle engine costs
+    // almost nothing.
+    using IdleCallback = bool(*)(void* userData);
+    void setIdleCallback(IdleCallback callback);
+
+    // TPDF dither for S16 output (no effect on S32/FLOAT). Set before initialize().
+    void setDither(bool enabled) { dither_ = enabled; }
+
     bool start();
     void stop();
 
     bool isRunning() const { return running_; }
     unsigned int getSampleRate() const { return sampleRate_; }
     unsigned int getBufferSize() const { return bufferSize_; }
+    bool usesMmap() const { return mmap_; }
 
 private:
     snd_pcm_t* handle_;
     AudioCallback callback_;
+    IdleCallback idleCallback_;
     void* callbackUserData_;
 
     unsigned int sampleRate_;
@@ -35,10 +50,27 @@ private:
     bool running_;
 
     snd_pcm_format_t format_;   // Audio format (S16_LE, S32_LE, or FLOAT_LE)
-    float* interleavedBuffer_;  // Temporary buffer for ALSA interleaved format
-    void* hwBuffer_;            // Hardware format buffer (for S16/S32 conversion)
+    bool mmap_;                 // MMAP_INTERLEAVED access (else RW_INTERLEAVED)
+    void* hwBuffer_;            // One period in hardware format (RW access only)
+    bool hwBufferSilent_;       // hwBuffer_ already holds a period of zeros
+    float* renderBuffer_;       // One interleaved float period (see initialize)
+    unsigned int frameBytes_;   // Bytes per stereo frame in format_
+    bool dither_;
+    Random ditherRng_;          // Dither noise (audio thread only)
+
+    RtLog log_;                 // Messages from the audio thread (never blocks)
 
     void runAudioLoop();
+
+    // Output one period (rendered, or silence). False on a fatal error.
+    bool writePeriodRw(bool silent);
+    bool writePeriodMmap(bool silent);
+    bool recover(int err);
+
+    // Render one period into dst (device format), converting if needed
+    void renderPeriod(void* dst);
+    void convertSamples(void* dst, const float* src, unsigned int frames);
+
     static void* audioThreadFunc(void* arg);
     pthread_t audioThread_;
 };
@@ -0,0 +1,112 @@
+#include "bank_file.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace phj {
+
+BankFile::BankFile()
+    : data_(nullptr)
+    , size_(0)
+    , records_(nullptr)
+    , recordSize_(0)
+    , count_(0)
+{
+}
+
+BankFile::~BankFile() {
+    close();
+}
+
+bool BankFile::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "Cannot open patch bank " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(BankHeader))) {
+        std::cerr << "Patch bank " << path << " is too small" << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    // Pre-fault the pages: program changes must not wait for the SD card
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    flags |= MAP_POPULATE;
+#endif
+    size_t size = static_cast<size_t>(info.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, flags, fd, 0);
+    ::close(fd);  // The mapping keeps the file
+    if (data == MAP_FAILED) {
+        std::cerr << "Cannot map patch bank " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    int count = 0;
+    size_t recordSize = 0;
+    const PatchRecord* records = findBankRecords(data, size, count, recordSize);
+    if (!records) {
+        std::cerr << "Patch bank " << path << " is not a version " << BANK_VERSION << " bank" << std::endl;
+        munmap(data, size);
+        return false;
+    }
+
+    data_ = data;
+    size_ = size;
+    records_ = reinterpret_cast<const char*>(records);
+    recordSize_ = recordSize;
+    count_ = count;
+    return true;
+}
+
+void BankFile::close() {
+    if (data_) {
+        munmap(data_, size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    records_ = nullptr;
+    recordSize_ = 0;
+    count_ = 0;
+}
+
+const PatchRecord* BankFile::getRecord(int program) const {
+    if (program < 0 || program >= count_) {
+        return nullptr;
+    }
+    return reinterpret_cast<const PatchRecord*>(records_ + static_cast<size_t>(program) * recordSize_);
+}
+
+bool BankFile::write(const std::string& path, const PatchRecord* records, int count) {
+    if (!records || count <= 0 || count > BANK_SIZE) {
+        return false;
+    }
+
+    const std::string tempPath = path + ".tmp";
+    FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Cannot create patch bank " << tempPath << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    const BankHeader header = makeBankHeader(count);
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(records, sizeof(PatchRecord), static_cast<size_t>(count), file) == static_cast<size_t>(count);
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Cannot write patch bank " << path << ": " << std::strerror(errno) << std::endl;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace phj
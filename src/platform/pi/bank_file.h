@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include "patch_bank.h"
+
+namespace phj {
+
+/**
+ * BankFile - Read-only memory-mapped patch bank (see patch_bank.h)
+ *
+ * open() maps the whole file read-only and checks the header; the records
+ * are never copied or parsed. A program change is then a pointer
+ * computation (getRecord) and a fixed set of field copies (decodePatch).
+ * The mapping is populated at open, so looking up a program later does not
+ * fault pages in from the SD card.
+ *
+ * write() replaces a bank file atomically (temporary file + rename), so a
+ * running instance that has the old file mapped keeps seeing the old bank.
+ */
+class BankFile {
+public:
+    BankFile();
+    ~BankFile();
+
+    BankFile(const BankFile&) = delete;
+    BankFile& operator=(const BankFile&) = delete;
+
+    // Map a bank file; prints the reason and returns false if it is missing,
+    // unreadable or not a bank
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return data_ != nullptr; }
+    int getCount() const { return count_; }
+
+    // Record for a program (0-based), or nullptr if the bank has no such program
+    const PatchRecord* getRecord(int program) const;
+
+    // Write count records (1 - BANK_SIZE) as a bank file
+    static bool write(const std::string& path, const PatchRecord* records, int count);
+
+private:
+    void* data_;         // Mapping (nullptr when closed)
+    size_t size_;
+    const char* records_;
+    size_t recordSize_;
+    int count_;
+};
+
+} // namespace phj
@@ -13,6 +13,9 @@
 #include <alsa/asoundlib.h>
 #include "audio_driver.h"
 #include "midi_driver.h"
+#include "rt_log.h"
+#include "resampler.h"
+#include "bank_file.h"
 #include "../../dsp/synth.h"
 
 using namespace phj;
@@ -28,6 +31,14 @@ void signalHandler(int signal) {
 // Global synth instance
 static Synth g_synth;
 
+// Engine rate -> device rate conversion (only used with --resample when the
+// device can't run at the requested rate)
+static Resampler g_resampler;
+static bool g_resampling = false;
+
+// Patch bank (mapped read-only at startup; Program Change selects a record)
+static BankFile g_bank;
+
 // CPU usage tracking
 struct CpuMonitor {
     std::atomic<float> cpuUsage{0.0f};
@@ -170,122 +181,168 @@ static MidiDeviceInfo chooseMidiDevice() {
     return devices.front();
 }
 
-// Audio callback
-void audioCallback(float* left, float* right, int numSamples, void* userData) {
+// Timestamp for queued events (CLOCK_MONOTONIC, nanoseconds)
+static uint64_t monotonicNanos() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+// Render numSamples frames at the engine rate
+static void renderSynth(float* interleaved, int numSamples, void* userData) {
     Synth* synth = static_cast<Synth*>(userData);
 
+    // MIDI that arrived during the last period is rendered at the same offset
+    // in this one: a constant one-period delay instead of callback jitter
+    uint64_t periodNanos = static_cast<uint64_t>(numSamples * 1e9 / synth->getSampleRate());
+    synth->setBlockTimestamp(monotonicNanos() - periodNanos);
+
+    // Process stereo output with chorus, interleaved for the device
+    synth->processInterleaved(interleaved, numSamples);
+}
+
+// Audio callback (numSamples frames at the device rate)
+void audioCallback(float* interleaved, int numSamples, void* userData) {
     // Measure processing time
     auto start = std::chrono::high_resolution_clock::now();
 
-    // Process stereo output with chorus
-    synth->processStereo(left, right, numSamples);
+    if (g_resampling) {
+        // Pulls one period's worth of engine-rate frames from the synth
+        g_resampler.process(interleaved, numSamples, renderSynth, userData);
+    } else {
+        renderSynth(interleaved, numSamples, userData);
+    }
 
     auto end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
     g_cpuMonitor.update(duration.count(), numSamples);
 }
 
-// MIDI callback
-void midiCallback(const uint8_t* data, int length, void* userData) {
-    Synth* synth = static_cast<Synth*>(userData);
+// Last idle state seen by the audio thread (read by the main loop)
+static std::atomic<bool> g_engineIdle(true);
 
-    if (length < 1) return;
+// Idle query: lets the audio thread skip DSP while nothing is sounding
+bool idleCallback(void* userData) {
+    bool idle = static_cast<Synth*>(userData)->isIdle();
+    g_engineIdle.store(idle, std::memory_order_relaxed);
+    return idle;
+}
 
-    uint8_t status = data[0] & 0xF0;
+// Log channel for the MIDI callback (MIDI thread)
+static RtLog g_midiInLog("midi-in");
 
-    // Handle MIDI messages
-    if (status == MIDI_NOTE_ON && length >= 3) {
-        uint8_t note = data[1];
-        uint8_t velocity = data[2];
+// Log a message received from the MIDI thread (debug verbosity)
+static void logMidiEvent(const MidiEvent& event) {
+    if (!RtLog::enabled(LogLevel::Debug)) {
+        return;
+    }
 
-        if (velocity > 0) {
-            float normalizedVelocity = velocity / 127.0f;
-            synth->handleNoteOn(note, normalizedVelocity);
-            std::cout << "Note ON: " << (int)note << ", vel=" << (int)velocity << std::endl;
+    uint8_t status = event.status & 0xF0;
+    if (status == MIDI_NOTE_ON && event.data2 > 0) {
+        g_midiInLog.log(LogLevel::Debug, "Note ON: %d, vel=%d", event.data1, event.data2);
+    } else if (status == MIDI_NOTE_ON || status == MIDI_NOTE_OFF) {
+        // Velocity 0 is treated as Note OFF
+        g_midiInLog.log(LogLevel::Debug, "Note OFF: %d", event.data1);
+    } else if (status == MIDI_CONTROL_CHANGE) {
+        g_midiInLog.log(LogLevel::Debug, "MIDI CC: %d = %d", event.data1, event.data2);
+    } else if (status == MIDI_PITCH_BEND) {
+        // M11: 14-bit pitch bend, 0-16383 -> -1.0 to 1.0
+        int bendValue = event.data1 | (event.data2 << 7);
+        g_midiInLog.log(LogLevel::Debug, "Pitch Bend: %.3f", (bendValue - 8192) / 8192.0f);
+    } else if (status == MIDI_PROGRAM_CHANGE) {
+        // The mapping is read-only, so the name can be read here too
+        const PatchRecord* record = g_bank.getRecord(event.data1);
+        if (record) {
+            g_midiInLog.log(LogLevel::Debug, "Program Change: %d (%.16s)", event.data1 + 1, record->name);
         } else {
-            // Velocity 0 is treated as Note OFF
-            synth->handleNoteOff(note);
-            std::cout << "Note OFF: " << (int)note << std::endl;
+            g_midiInLog.log(LogLevel::Debug, "Program Change: %d (no patch)", event.data1 + 1);
         }
-    } else if (status == MIDI_NOTE_OFF && length >= 3) {
-        uint8_t note = data[1];
-        synth->handleNoteOff(note);
-        std::cout << "Note OFF: " << (int)note << std::endl;
-    } else if (status == MIDI_CONTROL_CHANGE && length >= 3) {
-        uint8_t controller = data[1];
-        uint8_t value = data[2];
-        std::cout << "MIDI CC: " << (int)controller << " = " << (int)value << std::endl;
-
-        // M16: Handle all MIDI CC messages (including Arturia MiniLab support)
-        synth->handleControlChange(controller, value);
-    } else if (status == MIDI_PITCH_BEND && length >= 3) {
-        // M11: Pitch bend - combine data[1] (LSB) and data[2] (MSB) into 14-bit value
-        int bendValue = data[1] | (data[2] << 7);
-        // Convert from 0-16383 to -1.0 to 1.0
-        float bendNormalized = (bendValue - 8192) / 8192.0f;
-        synth->handlePitchBend(bendNormalized);
-        std::cout << "Pitch Bend: " << bendNormalized << std::endl;
     }
 }
 
+// Program Change lookup (audio thread): a pointer into the mapped bank
+static const PatchRecord* programLookup(int program, void* userData) {
+    return static_cast<const BankFile*>(userData)->getRecord(program);
+}
+
+// MIDI callback (MIDI thread): queue channel messages for the audio thread
+// and log them through the RT log, so this thread never touches the synth
+// or blocks on the console
+void midiCallback(const MidiEvent& event, void* userData) {
+    Synth* synth = static_cast<Synth*>(userData);
+
+    // System messages (clock, SysEx, ...) are not used by the synth;
+    // forwarding them would also keep an idle engine awake
+    if (event.status >= 0xF0) {
+        return;
+    }
+
+    if (!synth->postEvent(event)) {
+        g_midiInLog.log(LogLevel::Warning, "MIDI event queue full, dropping event");
+        return;
+    }
+    logMidiEvent(event);
+}
+
 // Default synth parameters (classic Juno sound)
-void initializeDefaultParameters(Synth& synth) {
+Patch defaultPatch() {
+    Patch patch;
+
     // DCO parameters - classic sawtooth with some pulse
-    DcoParams dcoParams;
-    dcoParams.sawLevel = 0.6f;
-    dcoParams.pulseLevel = 0.4f;
-    dcoParams.subLevel = 0.0f;
-    dcoParams.noiseLevel = 0.0f;
-    dcoParams.pulseWidth = 0.5f;
-    dcoParams.pwmDepth = 0.0f;
-    dcoParams.lfoTarget = DcoParams::LFO_OFF;
-    dcoParams.detune = 0.0f;
-    dcoParams.enableDrift = true;
-    synth.setDcoParameters(dcoParams);
+    patch.dco.sawLevel = 0.6f;
+    patch.dco.pulseLevel = 0.4f;
+    patch.dco.subLevel = 0.0f;
+    patch.dco.noiseLevel = 0.0f;
+    patch.dco.pulseWidth = 0.5f;
+    patch.dco.pwmDepth = 0.0f;
+    patch.dco.lfoTarget = DcoParams::LFO_OFF;
+    patch.dco.detune = 0.0f;
+    patch.dco.enableDrift = true;
 
     // Filter parameters - warm Juno sound
-    FilterParams filterParams;
-    filterParams.cutoff = 0.7f;
-    filterParams.resonance = 0.3f;
-    filterParams.envAmount = 0.15f;  // Reduced to prevent sweep artifact
-    filterParams.lfoAmount = 0.0f;
-    filterParams.keyTrack = FilterParams::KEY_TRACK_HALF;
-    filterParams.drive = 1.0f;
-    filterParams.hpfMode = 0;  // M11: HPF off by default
-    synth.setFilterParameters(filterParams);
+    patch.filter.cutoff = 0.7f;
+    patch.filter.resonance = 0.3f;
+    patch.filter.envAmount = 0.15f;  // Reduced to prevent sweep artifact
+    patch.filter.lfoAmount = 0.0f;
+    patch.filter.keyTrack = FilterParams::KEY_TRACK_HALF;
+    patch.filter.drive = 1.0f;
+    patch.filter.hpfMode = 0;  // M11: HPF off by default
 
     // Filter envelope - punchy but smooth
-    EnvelopeParams filterEnvParams;
-    filterEnvParams.attack = 0.01f;
-    filterEnvParams.decay = 0.4f;
-    filterEnvParams.sustain = 0.6f;
-    filterEnvParams.release = 0.5f;
-    synth.setFilterEnvParameters(filterEnvParams);
+    patch.filterEnv.attack = 0.01f;
+    patch.filterEnv.decay = 0.4f;
+    patch.filterEnv.sustain = 0.6f;
+    patch.filterEnv.release = 0.5f;
 
     // Amplitude envelope - fast attack
-    EnvelopeParams ampEnvParams;
-    ampEnvParams.attack = 0.005f;
-    ampEnvParams.decay = 0.3f;
-    ampEnvParams.sustain = 0.8f;
-    ampEnvParams.release = 0.3f;
-    synth.setAmpEnvParameters(ampEnvParams);
+    patch.ampEnv.attack = 0.005f;
+    patch.ampEnv.decay = 0.3f;
+    patch.ampEnv.sustain = 0.8f;
+    patch.ampEnv.release = 0.3f;
 
     // LFO parameters - moderate rate
-    LfoParams lfoParams;
-    lfoParams.rate = 3.0f;  // 3 Hz
-    synth.setLfoParameters(lfoParams);
+    patch.lfo.rate = 3.0f;  // 3 Hz
 
     // Chorus parameters - classic Juno chorus mode II
-    ChorusParams chorusParams;
-    chorusParams.mode = 2;  // Mode II
-    synth.setChorusParameters(chorusParams);
+    patch.chorus.mode = 2;  // Mode II
 
     // M11: Performance parameters - defaults
-    PerformanceParams performanceParams;
-    performanceParams.pitchBend = 0.0f;
-    performanceParams.pitchBendRange = 2.0f;  // ±2 semitones
-    performanceParams.portamentoTime = 0.0f;  // Off by default
-    synth.setPerformanceParameters(performanceParams);
+    patch.performance.pitchBend = 0.0f;
+    patch.performance.pitchBendRange = 2.0f;  // ±2 semitones
+    patch.performance.portamentoTime = 0.0f;  // Off by default
+
+    return patch;
+}
+
+// Write a bank with the default patch in every program
+bool writeDefaultBank(const std::string& path) {
+    static PatchRecord records[BANK_SIZE];
+    const Patch patch = defaultPatch();
+    for (int i = 0; i < BANK_SIZE; ++i) {
+        char name[PATCH_NAME_LENGTH + 1];
+        std::snprintf(name, sizeof(name), "Init %d", i + 1);
+        encodePatch(patch, name, records[i]);
+    }
+    return BankFile::write(path, records, BANK_SIZE);
 }
 
 // Load configuration from config file
@@ -293,6 +350,13 @@ struct Config {
     std::string audioDevice;
     std::string audioDeviceName;
     std::string midiDevice;
+    bool audioDither;   // TPDF dither for S16 output devices
+    unsigned int sampleRate;  // Requested device rate (the engine follows the device)
+    bool resample;      // Keep the engine at sampleRate and resample if the device differs
+    int midiPriority;   // MIDI thread SCHED_FIFO priority (0 = normal)
+    int midiCpu;        // MIDI thread CPU core (-1 = any)
+    std::string logLevel;
+    std::string bankFile;  // Patch bank (empty = ~/.config/poor-house-juno/bank.phb if present)
 };
 
 Config loadConfig() {
@@ -300,6 +364,13 @@ Config loadConfig() {
     config.audioDevice = "";  // Empty means not set
     config.audioDeviceName = "";
     config.midiDevice = "";
+    config.audioDither = false;
+    config.sampleRate = 48000;
+    config.resample = false;
+    config.midiPriority = 70;  // Below the audio thread (80)
+    config.midiCpu = -1;
+    config.logLevel = "";
+    config.bankFile = "";
 
     // Try to get HOME directory
     const char* home = std::getenv("HOME");
@@ -340,6 +411,20 @@ Config loadConfig() {
                 config.audioDeviceName = value;
             } else if (key == "MIDI_DEVICE" && !value.empty()) {
                 config.midiDevice = value;
+            } else if (key == "AUDIO_DITHER" && !value.empty()) {
+                config.audioDither = value != "0";
+            } else if (key == "SAMPLE_RATE" && !value.empty()) {
+                config.sampleRate = static_cast<unsigned int>(std::atoi(value.c_str()));
+            } else if (key == "RESAMPLE" && !value.empty()) {
+                config.resample = value != "0";
+            } else if (key == "MIDI_PRIORITY" && !value.empty()) {
+                config.midiPriority = std::atoi(value.c_str());
+            } else if (key == "MIDI_CPU" && !value.empty()) {
+                config.midiCpu = std::atoi(value.c_str());
+            } else if (key == "LOG_LEVEL" && !value.empty()) {
+                config.logLevel = value;
+            } else if (key == "BANK_FILE" && !value.empty()) {
+                config.bankFile = value;
             }
         }
     }
@@ -347,14 +432,26 @@ Config loadConfig() {
     return config;
 }
 
+// Shared by the startup banner and --help
+static void printUsage() {
+    std::cout << "Usage: poor-house-juno [--audio hw:X,Y,Z] [--midi hw:A,B,C | seq[:port,...]]" << std::endl;
+    std::cout << "                       [--midi-priority N] [--midi-cpu N]" << std::endl;
+    std::cout << "                       [--log-level error|warning|info|debug] [--dither]" << std::endl;
+    std::cout << "                       [--rate HZ] [--resample]" << std::endl;
+    std::cout << "                       [--bank FILE] [--write-bank FILE]" << std::endl;
+    std::cout << "       Config file: ~/.config/poor-house-juno/config" << std::endl;
+    std::cout << "       Env overrides: PHJ_AUDIO_DEVICE, PHJ_MIDI_DEVICE, PHJ_MIDI_PRIORITY, PHJ_MIDI_CPU," << std::endl;
+    std::cout << "                      PHJ_LOG_LEVEL, PHJ_AUDIO_DITHER, PHJ_SAMPLE_RATE, PHJ_RESAMPLE," << std::endl;
+    std::cout << "                      PHJ_BANK_FILE" << std::endl;
+    std::cout << "       Patch bank: ~/.config/poor-house-juno/bank.phb (or BANK_FILE= in the config file)" << std::endl;
+}
+
 int main(int argc, char** argv) {
     std::cout << "Poor House Juno - Raspberry Pi Edition" << std::endl;
     std::cout << "=======================================" << std::endl;
     std::cout << "6-Voice Polyphonic Juno-106 Emulator" << std::endl;
     std::cout << "=======================================" << std::endl;
-    std::cout << "Usage: poor-house-juno [--audio hw:X,Y,Z] [--midi hw:A,B,C]" << std::endl;
-    std::cout << "       Config file: ~/.config/poor-house-juno/config" << std::endl;
-    std::cout << "       Env overrides: PHJ_AUDIO_DEVICE, PHJ_MIDI_DEVICE" << std::endl;
+    printUsage();
 
     // Load config file
     Config config = loadConfig();
@@ -389,16 +486,70 @@ int main(int argc, char** argv) {
         midiOverride = envMidi;
     }
 
+    // MIDI thread scheduling (config file, then env)
+    int midiPriority = config.midiPriority;
+    int midiCpu = config.midiCpu;
+    if (const char* envPriority = std::getenv("PHJ_MIDI_PRIORITY")) {
+        midiPriority = std::atoi(envPriority);
+    }
+    if (const char* envCpu = std::getenv("PHJ_MIDI_CPU")) {
+        midiCpu = std::atoi(envCpu);
+    }
+
+    // Log verbosity (config file, then env); MIDI messages are logged at debug
+    std::string logLevel = config.logLevel;
+    if (const char* envLogLevel = std::getenv("PHJ_LOG_LEVEL")) {
+        logLevel = envLogLevel;
+    }
+
+    // S16 output dither (config file, then env)
+    bool audioDither = config.audioDither;
+    if (const char* envDither = std::getenv("PHJ_AUDIO_DITHER")) {
+        audioDither = std::string(envDither) != "0";
+    }
+
+    // Requested rate and resampling (config file, then env)
+    unsigned int requestedRate = config.sampleRate;
+    if (const char* envRate = std::getenv("PHJ_SAMPLE_RATE")) {
+        requestedRate = static_cast<unsigned int>(std::atoi(envRate));
+    }
+    bool resample = config.resample;
+    if (const char* envResample = std::getenv("PHJ_RESAMPLE")) {
+        resample = std::string(envResample) != "0";
+    }
+
+    // Patch bank (config file, then env); the default location is optional
+    std::string bankFile = config.bankFile;
+    bool bankRequired = !bankFile.empty();
+    if (const char* envBank = std::getenv("PHJ_BANK_FILE")) {
+        bankFile = envBank;
+        bankRequired = true;
+    }
+    if (bankFile.empty()) {
+        if (const char* home = std::getenv("HOME")) {
+            bankFile = std::string(home) + "/.config/poor-house-juno/bank.phb";
+        }
+    }
+    std::string writeBankFile;
+
     // CLI options
     static struct option longOptions[] = {
         {"audio", required_argument, nullptr, 'a'},
         {"midi", required_argument, nullptr, 'm'},
+        {"midi-priority", required_argument, nullptr, 'p'},
+        {"midi-cpu", required_argument, nullptr, 'c'},
+        {"log-level", required_argument, nullptr, 'l'},
+        {"dither", no_argument, nullptr, 'd'},
+        {"rate", required_argument, nullptr, 'r'},
+        {"resample", no_argument, nullptr, 's'},
+        {"bank", required_argument, nullptr, 'b'},
+        {"write-bank", required_argument, nullptr, 'w'},
         {"help", no_argument, nullptr, 'h'},
         {nullptr, 0, nullptr, 0}
     };
 
     int opt;
-    while ((opt = getopt_long(argc, argv, "a:m:h", longOptions, nullptr)) != -1) {
+    while ((opt = getopt_long(argc, argv, "a:m:p:c:l:dr:sb:w:h", longOptions, nullptr)) != -1) {
         switch (opt) {
             case 'a':
                 audioDevice = optarg;
@@ -407,22 +558,67 @@ int main(int argc, char** argv) {
             case 'm':
                 midiOverride = optarg;
                 break;
+            case 'p':
+                midiPriority = std::atoi(optarg);
+                break;
+            case 'c':
+                midiCpu = std::atoi(optarg);
+                break;
+            case 'l':
+                logLevel = optarg;
+                break;
+            case 'd':
+                audioDither = true;
+                break;
+            case 'r':
+                requestedRate = static_cast<unsigned int>(std::atoi(optarg));
+                break;
+            case 's':
+                resample = true;
+                break;
+            case 'b':
+                bankFile = optarg;
+                bankRequired = true;
+                break;
+            case 'w':
+                writeBankFile = optarg;
+                break;
             case 'h':
             default:
-                std::cout << "Usage: poor-house-juno [--audio hw:X,Y,Z] [--midi hw:A,B,C]" << std::endl;
+                printUsage();
                 return 0;
         }
     }
 
+    if (!logLevel.empty()) {
+        LogLevel level;
+        if (RtLog::parseLevel(logLevel.c_str(), level)) {
+            RtLog::setLevel(level);
+        } else {
+            std::cerr << "[WARNING] Unknown log level '" << logLevel << "', using info" << std::endl;
+        }
+    }
+
+    // --write-bank: create a bank to edit or fill, then exit
+    if (!writeBankFile.empty()) {
+        if (!writeDefaultBank(writeBankFile)) {
+            return 1;
+        }
+        std::cout << "Wrote " << BANK_SIZE << " default patches to " << writeBankFile << std::endl;
+        return 0;
+    }
+
+    // Logger thread: drains the real-time log channels of the MIDI and audio threads
+    RtLog::startLogger();
+
     // Setup signal handlers
     signal(SIGINT, signalHandler);
     signal(SIGTERM, signalHandler);
 
-    // Initialize synth with default parameters
-    const float sampleRate = 48000.0f;
-    g_synth.setSampleRate(sampleRate);
-    g_cpuMonitor.setSampleRate(sampleRate);
-    initializeDefaultParameters(g_synth);
+    if (requestedRate < 8000 || requestedRate > 192000) {
+        std::cerr << "[WARNING] Unsupported sample rate " << requestedRate << " Hz, using 48000 Hz" << std::endl;
+        requestedRate = 48000;
+    }
 
     // Initialize audio driver
     AudioDriver audio;
@@ -434,14 +630,49 @@ int main(int argc, char** argv) {
     } else {
         std::cout << "Selected device: " << audioDevice << std::endl;
     }
-    if (!audio.initialize(audioDevice, 48000, 128)) {
+    audio.setDither(audioDither);
+    if (!audio.initialize(audioDevice, requestedRate, 128)) {
         std::cerr << "\n[ERROR] Failed to initialize audio device '" << audioDevice << "'" << std::endl;
         std::cerr << "Run 'aplay -l' to list devices; try --audio hw:0,0 or set PHJ_AUDIO_DEVICE." << std::endl;
         return 1;
     }
     std::cout << "Audio device initialized successfully" << std::endl;
 
+    // The engine runs at the rate the device actually accepted, or at the
+    // requested rate through the resampler. All rate-dependent coefficients
+    // are rebuilt here, before the audio thread starts.
+    unsigned int engineRate = audio.getSampleRate();
+    if (resample && engineRate != requestedRate) {
+        if (g_resampler.configure(requestedRate, engineRate, static_cast<int>(audio.getBufferSize()))) {
+            g_resampling = true;
+            engineRate = requestedRate;
+            std::cout << "Resampling:      " << requestedRate << " Hz -> " << audio.getSampleRate() << " Hz ("
+                      << g_resampler.getTaps() << "-tap polyphase, " << g_resampler.getLatency() << " frames latency)"
+                      << std::endl;
+        } else {
+            std::cerr << "[WARNING] Cannot resample " << requestedRate << " Hz -> " << audio.getSampleRate()
+                      << " Hz, running the engine at " << engineRate << " Hz" << std::endl;
+        }
+    }
+
+    // Initialize synth with default parameters
+    g_synth.setSampleRate(static_cast<float>(engineRate));
+    g_cpuMonitor.setSampleRate(static_cast<float>(audio.getSampleRate()));
+    g_synth.setPatch(defaultPatch());
+
+    // Map the patch bank and start on its first program
+    if (!bankFile.empty() && (bankRequired || access(bankFile.c_str(), F_OK) == 0)) {
+        if (g_bank.open(bankFile)) {
+            g_synth.setPatch(decodePatch(*g_bank.getRecord(0)));
+            g_synth.setProgramLookup(programLookup, &g_bank);
+            std::cout << "Patch bank:      " << bankFile << " (" << g_bank.getCount() << " patches)" << std::endl;
+        } else {
+            std::cerr << "[WARNING] Program Change disabled, using the default patch" << std::endl;
+        }
+    }
+
     audio.setCallback(audioCallback, &g_synth);
+    audio.setIdleCallback(idleCallback);
 
     if (!audio.start()) {
         std::cerr << "Failed to start audio" << std::endl;
@@ -464,15 +695,30 @@ int main(int argc, char** argv) {
     std::cout << "Initializing MIDI" << std::endl;
     std::cout << "=======================================" << std::endl;
     std::cout << "Selected device: " << midiDevice.hwId << std::endl;
-    std::cout << "Device name:     " << midiDevice.cardName << " - " << midiDevice.deviceName << std::endl;
-    std::cout << "Device type:     " << (midiDevice.isGadget ? "USB gadget / DAW" : "Controller/Standalone") << std::endl;
 
-    if (!midi.initialize(midiDevice.hwId)) {
+    // "seq" or "seq:<port names>" selects the ALSA sequencer backend: all
+    // readable ports (or the matching ones), several controllers at once
+    bool useSequencer = midiDevice.hwId == "seq" || midiDevice.hwId.compare(0, 4, "seq:") == 0;
+    bool midiReady;
+    if (useSequencer) {
+        std::string portFilter = midiDevice.hwId.size() > 4 ? midiDevice.hwId.substr(4) : "";
+        std::cout << "Device type:     ALSA sequencer ("
+                  << (portFilter.empty() ? "all ports" : "ports matching " + portFilter) << ")" << std::endl;
+        midiReady = midi.initializeSequencer(portFilter);
+    } else {
+        std::cout << "Device name:     " << midiDevice.cardName << " - " << midiDevice.deviceName << std::endl;
+        std::cout << "Device type:     " << (midiDevice.isGadget ? "USB gadget / DAW" : "Controller/Standalone") << std::endl;
+        midiReady = midi.initialize(midiDevice.hwId);
+    }
+
+    if (!midiReady) {
         std::cerr << "[WARNING] Failed to initialize MIDI device " << midiDevice.hwId
                   << " (this is optional)" << std::endl;
         // Continue without MIDI
     } else {
         midi.setCallback(midiCallback, &g_synth);
+        midi.setRealtimePriority(midiPriority);
+        midi.setCpuAffinity(midiCpu);
         if (!midi.start()) {
             std::cerr << "[WARNING] Failed to start MIDI" << std::endl;
         } else {
@@ -489,6 +735,9 @@ int main(int argc, char** argv) {
         std::cout << "Audio device:    " << audioDevice << std::endl;
     }
     std::cout << "Sample rate:     " << audio.getSampleRate() << " Hz" << std::endl;
+    if (g_resampling) {
+        std::cout << "Engine rate:     " << g_synth.getSampleRate() << " Hz (resampled)" << std::endl;
+    }
     std::cout << "Buffer size:     " << audio.getBufferSize() << " samples" << std::endl;
     std::cout << "Latency:         ~" << (audio.getBufferSize() * 1000.0f / audio.getSampleRate()) << " ms" << std::endl;
     std::cout << "\nMIDI device:     " << midiDevice.hwId << std::endl;
@@ -504,11 +753,15 @@ int main(int argc, char** argv) {
         std::cout << "No MIDI available, playing test chord for 3 seconds..." << std::endl;
         std::cout << "(C major triad: C4, E4, G4)" << std::endl;
         std::cout << "Build timestamp: " << __DATE__ << " " << __TIME__ << std::endl;
-        g_synth.handleNoteOn(60, 0.8f);  // C4
-        g_synth.handleNoteOn(64, 0.8f);  // E4
-        g_synth.handleNoteOn(67, 0.8f);  // G4
+        // Posted like MIDI input so the synth is only touched by the audio thread
+        const uint8_t chord[] = {60, 64, 67};  // C4, E4, G4
+        for (uint8_t note : chord) {
+            g_synth.postEvent({monotonicNanos(), MIDI_NOTE_ON, note, 102});  // vel 0.8
+        }
         sleep(3);
-        g_synth.allNotesOff();
+        for (uint8_t note : chord) {
+            g_synth.postEvent({monotonicNanos(), MIDI_NOTE_OFF, note, 0});
+        }
         std::cout << "Test chord finished. Running idle (waiting for Ctrl+C)..." << std::endl;
     }
 
@@ -520,7 +773,7 @@ int main(int argc, char** argv) {
 
         if (loopCounter >= 5) {
             float cpuUsage = g_cpuMonitor.getCpuUsage();
-            if (cpuUsage > 0.0f) {
+            if (cpuUsage > 0.0f && !g_engineIdle.load(std::memory_order_relaxed)) {
                 std::cout << "CPU Usage: " << cpuUsage << "%" << std::endl;
             }
             loopCounter = 0;
@@ -531,6 +784,7 @@ int main(int argc, char** argv) {
 
     midi.shutdown();
     audio.shutdown();
+    RtLog::stopLogger();
 
     std::cout << "Goodbye!" << std::endl;
 
@@ -1,13 +1,44 @@
 #include "midi_driver.h"
 #include <iostream>
+#include <algorithm>
+#include <vector>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
 
 namespace phj {
 
+namespace {
+
+// Event timestamps share the clock used by the audio callback
+uint64_t monotonicNanos() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+constexpr uint64_t QUEUE_SYNC_INTERVAL_NS = 1000000000ULL;  // Re-measure queue offset every second
+
+} // namespace
+
 MidiDriver::MidiDriver()
     : handle_(nullptr)
+    , seq_(nullptr)
+    , seqPort_(-1)
+    , seqQueue_(-1)
+    , queueOffsetNs_(0)
+    , lastSyncNs_(0)
     , callback_(nullptr)
     , callbackUserData_(nullptr)
     , running_(false)
+    , rtPriority_(0)
+    , cpuCore_(-1)
+    , wakePipe_{-1, -1}
+    , log_("midi")
     , midiThread_(0)
 {
 }
@@ -23,10 +54,64 @@ bool MidiDriver::initialize(const std::string& deviceName) {
         return false;
     }
 
+    parser_.reset();
     std::cout << "MIDI initialized: " << deviceName << std::endl;
     return true;
 }
 
+bool MidiDriver::initializeSequencer(const std::string& portFilter) {
+    int err = snd_seq_open(&seq_, "default", SND_SEQ_OPEN_DUPLEX, SND_SEQ_NONBLOCK);
+    if (err < 0) {
+        std::cerr << "Cannot open ALSA sequencer: " << snd_strerror(err) << std::endl;
+        seq_ = nullptr;
+        return false;
+    }
+    snd_seq_set_client_name(seq_, "Poor House Juno");
+
+    // Queue that stamps incoming events with their (real-time) arrival time
+    seqQueue_ = snd_seq_alloc_named_queue(seq_, "Poor House Juno");
+    if (seqQueue_ < 0) {
+        std::cerr << "Cannot allocate sequencer queue: " << snd_strerror(seqQueue_) << std::endl;
+        shutdown();
+        return false;
+    }
+
+    // Input port; everything delivered to it is timestamped by the queue,
+    // whether we subscribed or someone else connected (aconnect, a DAW)
+    snd_seq_port_info_t* portInfo;
+    snd_seq_port_info_alloca(&portInfo);
+    snd_seq_port_info_set_name(portInfo, "MIDI In");
+    snd_seq_port_info_set_capability(portInfo, SND_SEQ_PORT_CAP_WRITE | SND_SEQ_PORT_CAP_SUBS_WRITE);
+    snd_seq_port_info_set_type(portInfo, SND_SEQ_PORT_TYPE_MIDI_GENERIC | SND_SEQ_PORT_TYPE_APPLICATION);
+    snd_seq_port_info_set_timestamping(portInfo, 1);
+    snd_seq_port_info_set_timestamp_real(portInfo, 1);
+    snd_seq_port_info_set_timestamp_queue(portInfo, seqQueue_);
+    err = snd_seq_create_port(seq_, portInfo);
+    if (err < 0) {
+        std::cerr << "Cannot create sequencer port: " << snd_strerror(err) << std::endl;
+        shutdown();
+        return false;
+    }
+    seqPort_ = snd_seq_port_info_get_port(portInfo);
+
+    snd_seq_start_queue(seq_, seqQueue_, nullptr);
+    snd_seq_drain_output(seq_);
+    syncQueueClock();
+
+    // Port announcements, so controllers plugged in later are picked up
+    err = snd_seq_connect_from(seq_, seqPort_, SND_SEQ_CLIENT_SYSTEM, SND_SEQ_PORT_SYSTEM_ANNOUNCE);
+    if (err < 0) {
+        std::cerr << "[WARNING] Cannot subscribe to sequencer announcements: " << snd_strerror(err) << std::endl;
+    }
+
+    portFilter_ = portFilter;
+    subscribeMatchingPorts();
+
+    std::cout << "MIDI initialized: ALSA sequencer client " << snd_seq_client_id(seq_)
+              << ":" << seqPort_ << std::endl;
+    return true;
+}
+
 void MidiDriver::shutdown() {
     stop();
 
@@ -34,6 +119,13 @@ void MidiDriver::shutdown() {
         snd_rawmidi_close(handle_);
         handle_ = nullptr;
     }
+
+    if (seq_) {
+        snd_seq_close(seq_);  // Also frees the port and queue
+        seq_ = nullptr;
+        seqPort_ = -1;
+        seqQueue_ = -1;
+    }
 }
 
 void MidiDriver::setCallback(MidiCallback callback, void* userData) {
@@ -42,7 +134,12 @@ void MidiDriver::setCallback(MidiCallback callback, void* userData) {
 }
 
 bool MidiDriver::start() {
-    if (running_ || !handle_ || !callback_) {
+    if (running_ || (!handle_ && !seq_) || !callback_) {
+        return false;
+    }
+
+    if (pipe(wakePipe_) != 0) {
+        std::cerr << "Failed to create MIDI wake pipe" << std::endl;
         return false;
     }
 
@@ -52,6 +149,9 @@ bool MidiDriver::start() {
     if (err != 0) {
         std::cerr << "Failed to create MIDI thread" << std::endl;
         running_ = false;
+        close(wakePipe_[0]);
+        close(wakePipe_[1]);
+        wakePipe_[0] = wakePipe_[1] = -1;
         return false;
     }
 
@@ -63,34 +163,287 @@ void MidiDriver::stop() {
 
     running_ = false;
 
+    // Wake the MIDI thread out of poll()
+    const char wake = 0;
+    if (write(wakePipe_[1], &wake, 1) != 1) {
+        std::cerr << "Failed to wake MIDI thread" << std::endl;
+    }
+
     if (midiThread_) {
         pthread_join(midiThread_, nullptr);
         midiThread_ = 0;
     }
+
+    close(wakePipe_[0]);
+    close(wakePipe_[1]);
+    wakePipe_[0] = wakePipe_[1] = -1;
 }
 
 void* MidiDriver::midiThreadFunc(void* arg) {
     MidiDriver* driver = static_cast<MidiDriver*>(arg);
+
+    // Pin to a core if requested (e.g. away from the audio thread's core)
+    if (driver->cpuCore_ >= 0) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(driver->cpuCore_, &cpuSet);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) != 0) {
+            driver->log_.log(LogLevel::Warning, "Could not pin MIDI thread to CPU %d", driver->cpuCore_);
+        } else {
+            driver->log_.log(LogLevel::Info, "MIDI thread pinned to CPU %d", driver->cpuCore_);
+        }
+    }
+
+    // Real-time priority, normally just below the audio thread
+    if (driver->rtPriority_ > 0) {
+        struct sched_param param;
+        param.sched_priority = driver->rtPriority_;
+        if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+            driver->log_.log(LogLevel::Warning, "Could not set real-time priority for MIDI thread (run as root or adjust system limits)");
+        } else {
+            driver->log_.log(LogLevel::Info, "MIDI thread running at real-time priority (SCHED_FIFO, priority %d)",
+                             driver->rtPriority_);
+        }
+    }
+
     driver->runMidiLoop();
     return nullptr;
 }
 
 void MidiDriver::runMidiLoop() {
-    uint8_t buffer[256];
+    // Poll set: the ALSA descriptors followed by the wake pipe
+    int midiCount = handle_ ? snd_rawmidi_poll_descriptors_count(handle_)
+                            : snd_seq_poll_descriptors_count(seq_, POLLIN);
+    if (midiCount <= 0) {
+        log_.log(LogLevel::Error, "MIDI device has no poll descriptors");
+        return;
+    }
+    std::vector<struct pollfd> fds(midiCount + 1);
+    if (handle_) {
+        snd_rawmidi_poll_descriptors(handle_, fds.data(), midiCount);
+    } else {
+        snd_seq_poll_descriptors(seq_, fds.data(), midiCount, POLLIN);
+    }
+    fds[midiCount].fd = wakePipe_[0];
+    fds[midiCount].events = POLLIN;
+    fds[midiCount].revents = 0;
 
     while (running_) {
-        ssize_t bytes = snd_rawmidi_read(handle_, buffer, sizeof(buffer));
+        // Sleep until MIDI arrives or stop() writes to the pipe
+        int ready = poll(fds.data(), fds.size(), -1);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            log_.log(LogLevel::Error, "MIDI poll error: %s", strerror(errno));
+            break;
+        }
 
-        if (bytes > 0) {
-            // Call user callback with MIDI data
-            callback_(buffer, bytes, callbackUserData_);
-        } else if (bytes < 0 && bytes != -EAGAIN) {
-            std::cerr << "MIDI read error: " << snd_strerror(bytes) << std::endl;
+        if (fds[midiCount].revents) {
+            break;  // Shutdown requested
         }
 
-        // Small sleep to avoid busy-waiting
-        usleep(1000);  // 1ms
+        if (handle_) {
+            unsigned short revents = 0;
+            snd_rawmidi_poll_descriptors_revents(handle_, fds.data(), midiCount, &revents);
+            if (revents & (POLLERR | POLLHUP)) {
+                log_.log(LogLevel::Error, "MIDI device disconnected");
+                break;
+            }
+            if (revents & POLLIN) {
+                readRawMidi();
+            }
+        } else if (!readSequencer()) {
+            break;
+        }
     }
 }
 
+void MidiDriver::readRawMidi() {
+    uint8_t buffer[256];
+
+    // Read everything that is available; every complete message goes out
+    // with the time of the read
+    ssize_t bytes;
+    while ((bytes = snd_rawmidi_read(handle_, buffer, sizeof(buffer))) > 0) {
+        uint64_t timestamp = monotonicNanos();
+        MidiEvent event;
+        for (ssize_t i = 0; i < bytes; ++i) {
+            if (parser_.processByte(buffer[i], timestamp, event)) {
+                callback_(event, callbackUserData_);
+            }
+        }
+    }
+
+    if (bytes < 0 && bytes != -EAGAIN) {
+        log_.log(LogLevel::Error, "MIDI read error: %s", snd_strerror(bytes));
+    }
+}
+
+bool MidiDriver::readSequencer() {
+    if (monotonicNanos() - lastSyncNs_ > QUEUE_SYNC_INTERVAL_NS) {
+        syncQueueClock();
+    }
+
+    snd_seq_event_t* ev = nullptr;
+    int err;
+    while ((err = snd_seq_event_input(seq_, &ev)) >= 0) {
+        if (ev) {
+            handleSequencerEvent(ev);
+        }
+    }
+
+    if (err == -ENOSPC) {
+        log_.log(LogLevel::Warning, "MIDI sequencer input overrun, events lost");
+    } else if (err != -EAGAIN) {
+        log_.log(LogLevel::Error, "MIDI sequencer read error: %s", snd_strerror(err));
+        return false;
+    }
+    return true;
+}
+
+bool MidiDriver::portMatches(const std::string& name) const {
+    if (portFilter_.empty()) {
+        return true;
+    }
+
+    // Comma-separated substrings, any of which may match
+    size_t start = 0;
+    while (start <= portFilter_.size()) {
+        size_t end = portFilter_.find(',', start);
+        if (end == std::string::npos) end = portFilter_.size();
+        std::string pattern = portFilter_.substr(start, end - start);
+        pattern.erase(0, pattern.find_first_not_of(" \t"));
+        pattern.erase(pattern.find_last_not_of(" \t") + 1);
+        if (!pattern.empty() && name.find(pattern) != std::string::npos) {
+            return true;
+        }
+        start = end + 1;
+    }
+    return false;
+}
+
+void MidiDriver::subscribePort(int client, int port) {
+    if (client == SND_SEQ_CLIENT_SYSTEM || client == snd_seq_client_id(seq_)) {
+        return;
+    }
+
+    snd_seq_client_info_t* clientInfo;
+    snd_seq_port_info_t* portInfo;
+    snd_seq_client_info_alloca(&clientInfo);
+    snd_seq_port_info_alloca(&portInfo);
+    if (snd_seq_get_any_client_info(seq_, client, clientInfo) < 0 ||
+        snd_seq_get_any_port_info(seq_, client, port, portInfo) < 0) {
+        return;
+    }
+
+    // Readable MIDI sources only
+    unsigned int caps = snd_seq_port_info_get_capability(portInfo);
+    const unsigned int readable = SND_SEQ_PORT_CAP_READ | SND_SEQ_PORT_CAP_SUBS_READ;
+    if ((caps & readable) != readable || (caps & SND_SEQ_PORT_CAP_NO_EXPORT)) {
+        return;
+    }
+
+    std::string name = std::string(snd_seq_client_info_get_name(clientInfo)) + ":" +
+                       snd_seq_port_info_get_name(portInfo);
+    if (!portMatches(name)) {
+        return;
+    }
+
+    int err = snd_seq_connect_from(seq_, seqPort_, client, port);
+    if (err < 0) {
+        log_.log(LogLevel::Warning, "Cannot subscribe to MIDI port %d:%d (%s): %s",
+                 client, port, name.c_str(), snd_strerror(err));
+        return;
+    }
+    log_.log(LogLevel::Info, "MIDI input: %d:%d (%s)", client, port, name.c_str());
+}
+
+void MidiDriver::subscribeMatchingPorts() {
+    snd_seq_client_info_t* clientInfo;
+    snd_seq_port_info_t* portInfo;
+    snd_seq_client_info_alloca(&clientInfo);
+    snd_seq_port_info_alloca(&portInfo);
+
+    snd_seq_client_info_set_client(clientInfo, -1);
+    while (snd_seq_query_next_client(seq_, clientInfo) >= 0) {
+        int client = snd_seq_client_info_get_client(clientInfo);
+        snd_seq_port_info_set_client(portInfo, client);
+        snd_seq_port_info_set_port(portInfo, -1);
+        while (snd_seq_query_next_port(seq_, portInfo) >= 0) {
+            subscribePort(client, snd_seq_port_info_get_port(portInfo));
+        }
+    }
+}
+
+void MidiDriver::syncQueueClock() {
+    // Offset between the queue's real-time clock and CLOCK_MONOTONIC, taken
+    // around one status query and refreshed periodically against drift
+    snd_seq_queue_status_t* status;
+    snd_seq_queue_status_alloca(&status);
+
+    uint64_t before = monotonicNanos();
+    if (snd_seq_get_queue_status(seq_, seqQueue_, status) < 0) {
+        return;
+    }
+    uint64_t after = monotonicNanos();
+
+    const snd_seq_real_time_t* queueTime = snd_seq_queue_status_get_real_time(status);
+    uint64_t queueNs = static_cast<uint64_t>(queueTime->tv_sec) * 1000000000ULL + queueTime->tv_nsec;
+    queueOffsetNs_ = static_cast<int64_t>(before + (after - before) / 2) - static_cast<int64_t>(queueNs);
+    lastSyncNs_ = after;
+}
+
+void MidiDriver::handleSequencerEvent(const snd_seq_event_t* ev) {
+    // Kernel arrival time from our queue, or now if the event is unstamped
+    uint64_t timestamp;
+    if ((ev->flags & SND_SEQ_TIME_STAMP_MASK) == SND_SEQ_TIME_STAMP_REAL && ev->queue == seqQueue_) {
+        int64_t queueNs = static_cast<int64_t>(ev->time.time.tv_sec) * 1000000000LL + ev->time.time.tv_nsec;
+        timestamp = static_cast<uint64_t>(queueNs + queueOffsetNs_);
+    } else {
+        timestamp = monotonicNanos();
+    }
+
+    MidiEvent event = {timestamp, 0, 0, 0};
+    switch (ev->type) {
+        case SND_SEQ_EVENT_NOTEON:
+        case SND_SEQ_EVENT_NOTEOFF:
+        case SND_SEQ_EVENT_KEYPRESS:
+            event.status = (ev->type == SND_SEQ_EVENT_NOTEON ? 0x90 :
+                            ev->type == SND_SEQ_EVENT_NOTEOFF ? 0x80 : 0xA0) | (ev->data.note.channel & 0x0F);
+            event.data1 = ev->data.note.note & 0x7F;
+            event.data2 = ev->data.note.velocity & 0x7F;
+            break;
+
+        case SND_SEQ_EVENT_CONTROLLER:
+            event.status = 0xB0 | (ev->data.control.channel & 0x0F);
+            event.data1 = ev->data.control.param & 0x7F;
+            event.data2 = ev->data.control.value & 0x7F;
+            break;
+
+        case SND_SEQ_EVENT_PGMCHANGE:
+        case SND_SEQ_EVENT_CHANPRESS:
+            event.status = (ev->type == SND_SEQ_EVENT_PGMCHANGE ? 0xC0 : 0xD0) | (ev->data.control.channel & 0x0F);
+            event.data1 = ev->data.control.value & 0x7F;
+            break;
+
+        case SND_SEQ_EVENT_PITCHBEND: {
+            // Sequencer pitch bend is signed (-8192..8191); MIDI is 14-bit offset
+            int value = std::min(std::max(ev->data.control.value + 8192, 0), 16383);
+            event.status = 0xE0 | (ev->data.control.channel & 0x0F);
+            event.data1 = value & 0x7F;
+            event.data2 = (value >> 7) & 0x7F;
+            break;
+        }
+
+        case SND_SEQ_EVENT_PORT_START:
+            // A new port appeared (e.g. controller plugged in)
+            subscribePort(ev->data.addr.client, ev->data.addr.port);
+            return;
+
+        default:
+            return;  // Clock, SysEx, connection notices, ...
+    }
+
+    callback_(event, callbackUserData_);
+}
+
 } // namespace phj
@@ -3,33 +3,93 @@
 #include <alsa/asoundlib.h>
 #include <string>
 #include <cstdint>
+#include "midi_parser.h"
+#include "rt_log.h"
 
 namespace phj {
 
+/**
+ * MidiDriver - ALSA MIDI input on its own thread
+ *
+ * Two backends deliver the same timestamped MidiEvents to the callback:
+ *
+ * - RawMIDI (initialize): one hw device. Bytes are parsed with MidiParser
+ *   and stamped with the CLOCK_MONOTONIC time of the read.
+ * - Sequencer (initializeSequencer): subscribes to every readable port (or
+ *   the ones whose name matches a filter), including ports that appear
+ *   later, so several controllers can be used at once. Events carry the
+ *   kernel's arrival time from a sequencer queue, converted to
+ *   CLOCK_MONOTONIC.
+ *
+ * The MIDI thread sleeps in poll() on the ALSA descriptors and wakes only
+ * when input arrives (no periodic polling). A self-pipe in the same poll set
+ * wakes the thread for shutdown. The thread can run with its own real-time
+ * priority and be pinned to a CPU core. Messages from the MIDI thread go
+ * through an RtLog channel ("midi"), so console output never blocks it.
+ */
 class MidiDriver {
 public:
     MidiDriver();
     ~MidiDriver();
 
+    // RawMIDI backend on one device (e.g. hw:1,0,0)
     bool initialize(const std::string& deviceName);
+
+    // Sequencer backend. portFilter is a comma-separated list of substrings
+    // matched against "client:port" names (e.g. "KeyStep,MiniLab");
+    // empty subscribes to all readable ports.
+    bool initializeSequencer(const std::string& portFilter);
+
     void shutdown();
 
-    // MIDI callback - called when MIDI message received
-    using MidiCallback = void(*)(const uint8_t* data, int length, void* userData);
+    // MIDI callback - called on the MIDI thread for every message received
+    using MidiCallback = void(*)(const MidiEvent& event, void* userData);
     void setCallback(MidiCallback callback, void* userData);
 
+    // Thread scheduling, applied by start(): SCHED_FIFO priority (1-99,
+    // 0 = normal scheduling) and the CPU core to pin to (-1 = any)
+    void setRealtimePriority(int priority) { rtPriority_ = priority; }
+    void setCpuAffinity(int cpuCore) { cpuCore_ = cpuCore; }
+
     bool start();
     void stop();
 
     bool isRunning() const { return running_; }
 
 private:
+    // RawMIDI backend
     snd_rawmidi_t* handle_;
+    MidiParser parser_;
+
+    // Sequencer backend
+    snd_seq_t* seq_;
+    int seqPort_;             // Our input port
+    int seqQueue_;            // Queue that timestamps incoming events
+    std::string portFilter_;
+    int64_t queueOffsetNs_;   // CLOCK_MONOTONIC minus queue time
+    uint64_t lastSyncNs_;     // When queueOffsetNs_ was last measured
+
     MidiCallback callback_;
     void* callbackUserData_;
     bool running_;
 
+    int rtPriority_;
+    int cpuCore_;
+    int wakePipe_[2];  // Self-pipe: written by stop() to wake poll()
+
+    RtLog log_;        // Messages from the MIDI thread (never blocks)
+
     void runMidiLoop();
+    void readRawMidi();
+    bool readSequencer();
+
+    // Sequencer helpers
+    bool portMatches(const std::string& name) const;
+    void subscribePort(int client, int port);
+    void subscribeMatchingPorts();
+    void syncQueueClock();
+    void handleSequencerEvent(const snd_seq_event_t* ev);
+
     static void* midiThreadFunc(void* arg);
     pthread_t midiThread_;
 };
@@ -0,0 +1,104 @@
+#include "midi_parser.h"
+
+namespace phj {
+
+MidiParser::MidiParser() {
+    reset();
+}
+
+void MidiParser::reset() {
+    status_ = 0;
+    data_[0] = 0;
+    data_[1] = 0;
+    dataCount_ = 0;
+    dataExpected_ = 0;
+    inSysex_ = false;
+}
+
+int MidiParser::dataLength(uint8_t status) {
+    switch (status & 0xF0) {
+        case 0x80:  // Note Off
+        case 0x90:  // Note On
+        case 0xA0:  // Poly Aftertouch
+        case 0xB0:  // Control Change
+        case 0xE0:  // Pitch Bend
+            return 2;
+        case 0xC0:  // Program Change
+        case 0xD0:  // Channel Pressure
+            return 1;
+        default:
+            break;
+    }
+
+    switch (status) {
+        case 0xF1:  // MTC Quarter Frame
+        case 0xF3:  // Song Select
+            return 1;
+        case 0xF2:  // Song Position Pointer
+            return 2;
+        default:
+            return 0;  // Tune Request, realtime, undefined
+    }
+}
+
+bool MidiParser::processByte(uint8_t byte, uint64_t timestamp, MidiEvent& event) {
+    // Realtime: single byte, allowed anywhere, leaves all other state alone
+    if (byte >= 0xF8) {
+        event = {timestamp, byte, 0, 0};
+        return true;
+    }
+
+    if (byte & 0x80) {
+        dataCount_ = 0;
+
+        if (byte == 0xF0) {
+            // SysEx start: skip until EOX or the next status byte
+            inSysex_ = true;
+            status_ = 0;
+            return false;
+        }
+
+        inSysex_ = false;
+
+        if (byte == 0xF7) {
+            // EOX (or a stray one): nothing to report
+            status_ = 0;
+            return false;
+        }
+
+        dataExpected_ = dataLength(byte);
+
+        if (byte >= 0xF0) {
+            // System common: cancels running status
+            status_ = 0;
+            if (dataExpected_ == 0) {
+                event = {timestamp, byte, 0, 0};
+                return true;
+            }
+        }
+
+        status_ = byte;
+        return false;
+    }
+
+    // Data byte
+    if (inSysex_ || status_ == 0) {
+        return false;
+    }
+
+    data_[dataCount_++] = byte;
+    if (dataCount_ < dataExpected_) {
+        return false;
+    }
+
+    event = {timestamp, status_, data_[0], dataExpected_ == 2 ? data_[1] : uint8_t(0)};
+    dataCount_ = 0;
+
+    // Only channel messages establish running status
+    if (status_ >= 0xF0) {
+        status_ = 0;
+    }
+    return true;
+}
+
+} // namespace phj
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include "../../dsp/event_queue.h"
+
+namespace phj {
+
+/**
+ * MidiParser - Incremental MIDI 1.0 byte stream parser
+ *
+ * Raw MIDI input arrives in arbitrary chunks: several messages per read,
+ * messages split across reads, running status (repeated channel messages
+ * without their status byte), realtime bytes interleaved anywhere (even
+ * inside another message) and SysEx. The parser is fed one byte at a time
+ * and reports each complete message as a MidiEvent:
+ *
+ * - Channel messages (0x80-0xEF) with their 1 or 2 data bytes
+ * - System common messages (0xF1-0xF6); they cancel running status
+ * - Realtime messages (0xF8-0xFF); they do not disturb the message in progress
+ *
+ * SysEx (0xF0 ... 0xF7) is skipped; any status byte other than realtime ends
+ * it. Data bytes with no status to apply to are dropped.
+ *
+ * ALSA-free, so it is unit tested with the DSP code.
+ */
+class MidiParser {
+public:
+    MidiParser();
+
+    // Feed one byte. Returns true when it completes a message, which is
+    // written to event with the given timestamp.
+    bool processByte(uint8_t byte, uint64_t timestamp, MidiEvent& event);
+
+    // Forget any partial message, running status and SysEx state
+    void reset();
+
+    // Number of data bytes that follow a status byte (0 for realtime/unknown)
+    static int dataLength(uint8_t status);
+
+private:
+    uint8_t status_;      // Current (running) status, 0 = none
+    uint8_t data_[2];
+    int dataCount_;       // Data bytes received for the current message
+    int dataExpected_;    // Data bytes needed to complete it
+    bool inSysex_;
+};
+
+} // namespace phj
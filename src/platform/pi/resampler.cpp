@@ -0,0 +1,166 @@
+#include "resampler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+namespace phj {
+
+namespace {
+
+// 32 input frames each side at 1:1. With beta 9 (about 90 dB stopband) the
+// transition band is ~18% of Nyquist, so a cutoff of 0.91 puts the stopband
+// edge at Nyquist and keeps the passband flat to ~0.82 (18 kHz at 44.1 kHz).
+constexpr int BASE_TAPS = 64;
+constexpr double KAISER_BETA = 9.0;
+constexpr double CUTOFF = 0.91;
+constexpr double PI = 3.14159265358979323846;
+
+// Zeroth-order modified Bessel function of the first kind (power series)
+double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    const double q = x * x / 4.0;
+    for (int k = 1; k < 50 && term > sum * 1e-17; ++k) {
+        term *= q / (static_cast<double>(k) * k);
+        sum += term;
+    }
+    return sum;
+}
+
+double sinc(double x) {
+    return x == 0.0 ? 1.0 : std::sin(PI * x) / (PI * x);
+}
+
+} // namespace
+
+Resampler::Resampler()
+    : inRate_(0)
+    , outRate_(0)
+    , phases_(1)
+    , step_(1)
+    , taps_(0)
+    , maxOutFrames_(0)
+    , pos_(0)
+    , phase_(0)
+    , fill_(0)
+{
+}
+
+bool Resampler::configure(unsigned int inRate, unsigned int outRate, int maxOutFrames) {
+    if (inRate == 0 || outRate == 0 || maxOutFrames <= 0) {
+        return false;
+    }
+    const unsigned int divisor = std::gcd(inRate, outRate);
+    const unsigned int phases = outRate / divisor;
+    const unsigned int step = inRate / divisor;
+    if (phases > static_cast<unsigned int>(MAX_PHASES)) {
+        return false;
+    }
+
+    inRate_ = inRate;
+    outRate_ = outRate;
+    phases_ = static_cast<int>(phases);
+    step_ = static_cast<int>(step);
+    maxOutFrames_ = maxOutFrames;
+    coeffs_.clear();
+    input_.clear();
+    taps_ = 0;
+
+    if (phases_ == step_) {
+        // Same rate: process() passes the source straight through
+        reset();
+        return true;
+    }
+
+    // Cutoff relative to the input Nyquist; decimation widens the kernel
+    const double ratio = std::min(1.0, static_cast<double>(phases_) / step_);
+    const double cutoff = CUTOFF * ratio;
+    taps_ = static_cast<int>(std::ceil(BASE_TAPS / ratio / 2.0)) * 2;
+
+    // Phase p interpolates at fractional position p / L after the window's
+    // centre frame (taps_/2 - 1). Each phase is normalised to unity DC gain.
+    const int centre = taps_ / 2 - 1;
+    const double halfWidth = taps_ / 2.0;
+    const double windowNorm = besselI0(KAISER_BETA);
+    coeffs_.resize(static_cast<size_t>(phases_) * taps_);
+    std::vector<double> h(taps_);
+    for (int p = 0; p < phases_; ++p) {
+        float* phase = &coeffs_[static_cast<size_t>(p) * taps_];
+        double sum = 0.0;
+        for (int k = 0; k < taps_; ++k) {
+            double t = k - centre - static_cast<double>(p) / phases_;
+            double w = t / halfWidth;
+            double window = std::abs(w) < 1.0 ? besselI0(KAISER_BETA * std::sqrt(1.0 - w * w)) / windowNorm : 0.0;
+            h[k] = cutoff * sinc(cutoff * t) * window;
+            sum += h[k];
+        }
+        for (int k = 0; k < taps_; ++k) {
+            phase[k] = static_cast<float>(h[k] / sum);
+        }
+    }
+
+    // Worst case for one block: the window for the last output frame starts
+    // (L - 1 + (n - 1) * M) / L frames after the current one
+    const long long span = (static_cast<long long>(phases_) - 1 + static_cast<long long>(maxOutFrames - 1) * step_) / phases_;
+    input_.resize(static_cast<size_t>(taps_ + span + 1) * 2);
+
+    reset();
+    return true;
+}
+
+void Resampler::reset() {
+    // Prime with silence so the first output frame lines up with the first
+    // input frame (centre of the window)
+    pos_ = 0;
+    phase_ = 0;
+    fill_ = taps_ > 0 ? taps_ / 2 - 1 : 0;
+    std::fill(input_.begin(), input_.end(), 0.0f);
+}
+
+void Resampler::process(float* out, int numFrames, Source source, void* userData) {
+    if (phases_ == step_) {
+        source(out, numFrames, userData);
+        return;
+    }
+    while (numFrames > 0) {
+        int frames = std::min(numFrames, maxOutFrames_);
+        processBlock(out, frames, source, userData);
+        out += frames * 2;
+        numFrames -= frames;
+    }
+}
+
+void Resampler::processBlock(float* out, int numFrames, Source source, void* userData) {
+    // Pull exactly what the last output frame's window needs
+    const int lastPos = pos_ + static_cast<int>((static_cast<long long>(phase_) + static_cast<long long>(numFrames - 1) * step_) / phases_);
+    const int needed = lastPos + taps_ - fill_;
+    if (needed > 0) {
+        // Drop frames no longer under the window, then append the new ones
+        const int kept = fill_ - pos_;
+        std::memmove(input_.data(), input_.data() + pos_ * 2, static_cast<size_t>(kept) * 2 * sizeof(float));
+        fill_ = kept;
+        source(input_.data() + fill_ * 2, needed, userData);
+        fill_ += needed;
+        pos_ = 0;
+    }
+
+    for (int n = 0; n < numFrames; ++n) {
+        const float* c = &coeffs_[static_cast<size_t>(phase_) * taps_];
+        const float* x = &input_[static_cast<size_t>(pos_) * 2];
+        float left = 0.0f;
+        float right = 0.0f;
+        for (int k = 0; k < taps_; ++k) {
+            left += c[k] * x[2 * k];
+            right += c[k] * x[2 * k + 1];
+        }
+        out[2 * n] = left;
+        out[2 * n + 1] = right;
+
+        phase_ += step_;
+        pos_ += phase_ / phases_;
+        phase_ %= phases_;
+    }
+}
+
+} // namespace phj
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vector>
+
+namespace phj {
+
+/**
+ * Resampler - Polyphase windowed-sinc sample rate converter
+ *
+ * Lets the engine run at its own rate on fixed-rate hardware (e.g. the synth
+ * at 48 kHz on a 44.1 kHz-only DAC). The ratio is reduced to out/in = L/M and
+ * each output frame is a dot product of the input with one of L precomputed
+ * filter phases, so the conversion is exact in time with no drift. The
+ * filter is a Kaiser-windowed sinc (about 90 dB stopband) with its cutoff just
+ * below the lower of the two Nyquist frequencies; when decimating, the kernel
+ * is widened to keep the same relative transition band.
+ *
+ * Pull model: process() asks the source for exactly the input frames needed
+ * for the requested output (one call per period), so the engine still sees
+ * one render per period and the only added latency is half the filter.
+ *
+ * configure() allocates and builds the table (not real-time safe); process()
+ * does neither. Interleaved stereo in and out.
+ */
+class Resampler {
+public:
+    // Same shape as AudioDriver::AudioCallback
+    using Source = void(*)(float* interleaved, int numFrames, void* userData);
+
+    Resampler();
+
+    // Build the filter for inRate -> outRate and size the buffers for up to
+    // maxOutFrames per process() call (larger requests are split). Returns
+    // false if the reduced ratio needs more than MAX_PHASES phases.
+    bool configure(unsigned int inRate, unsigned int outRate, int maxOutFrames);
+
+    // Clear the input history (keeps the filter)
+    void reset();
+
+    // Fill numFrames output frames, pulling input from source
+    void process(float* out, int numFrames, Source source, void* userData);
+
+    unsigned int getInputRate() const { return inRate_; }
+    unsigned int getOutputRate() const { return outRate_; }
+    int getTaps() const { return taps_; }
+
+    // Delay through the filter, in input frames
+    int getLatency() const { return taps_ / 2; }
+
+    static constexpr int MAX_PHASES = 1024;
+
+private:
+    unsigned int inRate_;
+    unsigned int outRate_;
+    int phases_;             // L: output frames per M input frames
+    int step_;               // M
+    int taps_;               // Filter length per phase (even)
+    int maxOutFrames_;
+    std::vector<float> coeffs_;   // phases_ x taps_, phase-major
+
+    // Input history, interleaved; frames [pos_, fill_) are still needed
+    std::vector<float> input_;
+    int pos_;                // First frame under the filter window
+    int phase_;              // Current phase (0..phases_-1)
+    int fill_;
+
+    void processBlock(float* out, int numFrames, Source source, void* userData);
+};
+
+} // namespace phj
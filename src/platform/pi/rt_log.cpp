@@ -0,0 +1,197 @@
+#include "rt_log.h"
+#include <iostream>
+#include <mutex>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <pthread.h>
+#include <semaphore.h>
+
+namespace phj {
+
+std::atomic<LogLevel> RtLog::level_(LogLevel::Info);
+
+namespace {
+
+constexpr int MAX_CHANNELS = 8;
+
+void defaultSink(LogLevel level, const char* channel, const char* message) {
+    std::ostream& out = level <= LogLevel::Warning ? std::cerr : std::cout;
+    out << "[" << channel << "] " << message << std::endl;
+}
+
+// Registry and logger thread state (function-local: safe to use from
+// static RtLog instances regardless of initialization order)
+struct LoggerState {
+    std::mutex mutex;                 // Guards channels[] and draining (never taken by producers)
+    RtLog* channels[MAX_CHANNELS] = {};
+    RtLog::Sink sink = defaultSink;
+
+    sem_t wake;                       // Posted by producers (sem_post is lock-free)
+    std::atomic<bool> running{false};
+    std::atomic<bool> stopRequested{false};
+    pthread_t thread = 0;
+
+    LoggerState() { sem_init(&wake, 0, 0); }
+};
+
+LoggerState& state() {
+    static LoggerState instance;
+    return instance;
+}
+
+void* loggerThreadFunc(void*) {
+    LoggerState& s = state();
+    while (!s.stopRequested.load(std::memory_order_acquire)) {
+        if (sem_wait(&s.wake) != 0 && errno == EINTR) {
+            continue;
+        }
+        RtLog::flush();
+    }
+    RtLog::flush();
+    return nullptr;
+}
+
+} // namespace
+
+RtLog::RtLog(const char* name)
+    : name_(name)
+    , dropped_(0)
+    , droppedReported_(0)
+{
+    LoggerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    for (RtLog*& channel : s.channels) {
+        if (!channel) {
+            channel = this;
+            return;
+        }
+    }
+    std::cerr << "RtLog: too many channels, '" << name << "' will not be drained" << std::endl;
+}
+
+RtLog::~RtLog() {
+    LoggerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    drain();
+    for (RtLog*& channel : s.channels) {
+        if (channel == this) {
+            channel = nullptr;
+        }
+    }
+}
+
+void RtLog::log(LogLevel level, const char* format, ...) {
+    if (!enabled(level)) {
+        return;
+    }
+
+    Record record;
+    record.level = level;
+    va_list args;
+    va_start(args, format);
+    vsnprintf(record.message, sizeof(record.message), format, args);
+    va_end(args);
+
+    if (!ring_.push(record)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    LoggerState& s = state();
+    if (s.running.load(std::memory_order_relaxed)) {
+        sem_post(&s.wake);
+    }
+}
+
+bool RtLog::parseLevel(const char* text, LogLevel& level) {
+    static const struct { const char* name; LogLevel level; } levels[] = {
+        {"error", LogLevel::Error},
+        {"warning", LogLevel::Warning},
+        {"info", LogLevel::Info},
+        {"debug", LogLevel::Debug},
+    };
+    for (const auto& entry : levels) {
+        if (std::strcmp(text, entry.name) == 0) {
+            level = entry.level;
+            return true;
+        }
+    }
+    return false;
+}
+
+void RtLog::setSink(Sink sink) {
+    LoggerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.sink = sink ? sink : defaultSink;
+}
+
+bool RtLog::startLogger() {
+    LoggerState& s = state();
+    if (s.running.load()) {
+        return true;
+    }
+
+    // Normal (non real-time) scheduling, even if started from an RT thread
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(&attr, SCHED_OTHER);
+    struct sched_param param = {};
+    pthread_attr_setschedparam(&attr, &param);
+
+    s.stopRequested.store(false);
+    int err = pthread_create(&s.thread, &attr, loggerThreadFunc, nullptr);
+    pthread_attr_destroy(&attr);
+    if (err != 0) {
+        std::cerr << "Failed to create logger thread" << std::endl;
+        return false;
+    }
+    s.running.store(true);
+    return true;
+}
+
+void RtLog::stopLogger() {
+    LoggerState& s = state();
+    if (!s.running.load()) {
+        flush();
+        return;
+    }
+
+    s.stopRequested.store(true, std::memory_order_release);
+    sem_post(&s.wake);
+    pthread_join(s.thread, nullptr);
+    s.thread = 0;
+    s.running.store(false);
+}
+
+void RtLog::flush() {
+    LoggerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    for (RtLog* channel : s.channels) {
+        if (channel) {
+            channel->drain();
+        }
+    }
+}
+
+void RtLog::drain() {
+    // Called with the registry mutex held (consumer side of the ring)
+    Sink sink = state().sink;
+
+    Record record;
+    while (ring_.pop(record)) {
+        sink(record.level, name_, record.message);
+    }
+
+    uint32_t dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped != droppedReported_) {
+        char message[MESSAGE_SIZE];
+        snprintf(message, sizeof(message), "%u log messages dropped (ring full)", dropped - droppedReported_);
+        sink(LogLevel::Warning, name_, message);
+        droppedReported_ = dropped;
+    }
+}
+
+} // namespace phj
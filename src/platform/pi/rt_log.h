@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "../../dsp/event_queue.h"
+
+namespace phj {
+
+enum class LogLevel : uint8_t {
+    Error = 0,
+    Warning,
+    Info,
+    Debug
+};
+
+/**
+ * RtLog - Real-time safe logging channel
+ *
+ * Threads that must never block (MIDI, audio) log through their own
+ * RtLog: log() formats into a fixed-size record on the stack and pushes it
+ * into a preallocated SPSC ring, with no locks, allocation or I/O. If the
+ * ring is full the message is dropped and counted. A low-priority logger
+ * thread (startLogger) drains every channel to stdout/stderr.
+ *
+ * Verbosity is global and can be changed at runtime; messages above the
+ * current level are filtered before any formatting happens.
+ *
+ * Each channel has exactly one producer thread. Channels register
+ * themselves on construction (not real-time safe: create them up front).
+ */
+class RtLog {
+public:
+    explicit RtLog(const char* name);
+    ~RtLog();
+
+    RtLog(const RtLog&) = delete;
+    RtLog& operator=(const RtLog&) = delete;
+
+    // printf-style; long messages are truncated to MESSAGE_SIZE - 1 chars
+    void log(LogLevel level, const char* format, ...) __attribute__((format(printf, 3, 4)));
+
+    // Global verbosity (messages with level <= this are kept)
+    static void setLevel(LogLevel level) { level_.store(level, std::memory_order_relaxed); }
+    static LogLevel getLevel() { return level_.load(std::memory_order_relaxed); }
+    static bool enabled(LogLevel level) { return level <= getLevel(); }
+
+    // Parse "error", "warning", "info" or "debug"; false if unknown
+    static bool parseLevel(const char* text, LogLevel& level);
+
+    // Output for drained messages (default: stderr for errors/warnings,
+    // stdout otherwise). Set before starting the logger.
+    using Sink = void(*)(LogLevel level, const char* channel, const char* message);
+    static void setSink(Sink sink);
+
+    // Low-priority thread that drains all channels as messages arrive
+    static bool startLogger();
+    static void stopLogger();
+
+    // Drain all channels on the calling thread (also done by stopLogger)
+    static void flush();
+
+    static constexpr int MESSAGE_SIZE = 120;
+    static constexpr int RING_SIZE = 256;  // Records per channel
+
+private:
+    struct Record {
+        LogLevel level;
+        char message[MESSAGE_SIZE];
+    };
+
+    const char* name_;
+    SpscQueue<Record, RING_SIZE> ring_;
+    std::atomic<uint32_t> dropped_;   // Messages lost to a full ring
+    uint32_t droppedReported_;        // Logger thread side
+
+    void drain();
+
+    static std::atomic<LogLevel> level_;
+};
+
+} // namespace phj
@@ -0,0 +1,208 @@
+#include "sample_convert.h"
+#include <algorithm>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+#elif defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace phj {
+namespace sampleconv {
+
+namespace {
+
+constexpr float S16_SCALE = 32767.0f;
+constexpr float S32_SCALE = 2147483648.0f;   // 2^31: exact for clamped input
+constexpr float S32_MAX = 2147483520.0f;     // Largest float below 2^31
+
+// Dithered S16 works in fixed point with 15 fractional bits: the noise is
+// added as an integer and the arithmetic shift floors, so the result does not
+// depend on float evaluation order (-ffast-math may reassociate float adds)
+constexpr int DITHER_FRACTION_BITS = 15;
+constexpr float DITHER_SCALE = S16_SCALE * (1 << DITHER_FRACTION_BITS);
+constexpr int32_t DITHER_ROUND = 1 << (DITHER_FRACTION_BITS - 1);  // Round to nearest
+
+inline float clampUnit(float x) {
+    return std::min(std::max(x, -1.0f), 1.0f);
+}
+
+// Triangular noise in (-1, 1) LSB: difference of two 15-bit uniforms taken
+// from one generator call. Returned in fixed point with the rounding offset.
+inline int32_t ditherNoise(Random& rng) {
+    uint32_t r = rng.nextUInt();
+    int32_t difference = static_cast<int32_t>(r & 0x7FFFu) - static_cast<int32_t>((r >> 16) & 0x7FFFu);
+    return difference + DITHER_ROUND;
+}
+
+inline int16_t ditheredSample(float x, int32_t noise) {
+    int32_t v = (static_cast<int32_t>(clampUnit(x) * DITHER_SCALE) + noise) >> DITHER_FRACTION_BITS;
+    return static_cast<int16_t>(std::min(std::max(v, int32_t(-32768)), int32_t(32767)));
+}
+
+} // namespace
+
+// ----------------------------------------------------------------------------
+// Scalar reference
+// ----------------------------------------------------------------------------
+
+namespace reference {
+
+void floatToS16(const float* in, int16_t* out, int count) {
+    for (int i = 0; i < count; ++i) {
+        out[i] = static_cast<int16_t>(static_cast<int32_t>(clampUnit(in[i]) * S16_SCALE));
+    }
+}
+
+void floatToS32(const float* in, int32_t* out, int count) {
+    for (int i = 0; i < count; ++i) {
+        out[i] = static_cast<int32_t>(std::min(clampUnit(in[i]) * S32_SCALE, S32_MAX));
+    }
+}
+
+void floatToS16Dithered(const float* in, int16_t* out, int count, Random& rng) {
+    for (int i = 0; i < count; ++i) {
+        out[i] = ditheredSample(in[i], ditherNoise(rng));
+    }
+}
+
+} // namespace reference
+
+// ----------------------------------------------------------------------------
+// SIMD kernels: 8 samples per step, the remainder goes through the reference
+// ----------------------------------------------------------------------------
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+const char* kernelName() { return "NEON"; }
+
+namespace {
+
+inline float32x4_t clampUnit4(float32x4_t x) {
+    return vminq_f32(vmaxq_f32(x, vdupq_n_f32(-1.0f)), vdupq_n_f32(1.0f));
+}
+
+inline int16x4_t s16x4(float32x4_t x) {
+    return vmovn_s32(vcvtq_s32_f32(vmulq_f32(clampUnit4(x), vdupq_n_f32(S16_SCALE))));
+}
+
+inline int32x4_t s32x4(float32x4_t x) {
+    return vcvtq_s32_f32(vminq_f32(vmulq_f32(clampUnit4(x), vdupq_n_f32(S32_SCALE)), vdupq_n_f32(S32_MAX)));
+}
+
+inline int16x4_t dithered4(float32x4_t x, int32x4_t noise) {
+    int32x4_t v = vcvtq_s32_f32(vmulq_f32(clampUnit4(x), vdupq_n_f32(DITHER_SCALE)));
+    return vqmovn_s32(vshrq_n_s32(vaddq_s32(v, noise), DITHER_FRACTION_BITS));  // Saturating narrow
+}
+
+} // namespace
+
+void floatToS16(const float* in, int16_t* out, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        vst1q_s16(out + i, vcombine_s16(s16x4(vld1q_f32(in + i)), s16x4(vld1q_f32(in + i + 4))));
+    }
+    reference::floatToS16(in + i, out + i, count - i);
+}
+
+void floatToS32(const float* in, int32_t* out, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        vst1q_s32(out + i, s32x4(vld1q_f32(in + i)));
+        vst1q_s32(out + i + 4, s32x4(vld1q_f32(in + i + 4)));
+    }
+    reference::floatToS32(in + i, out + i, count - i);
+}
+
+void floatToS16Dithered(const float* in, int16_t* out, int count, Random& rng) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        int32_t noise[8];
+        for (int32_t& n : noise) {
+            n = ditherNoise(rng);
+        }
+        int16x4_t lo = dithered4(vld1q_f32(in + i), vld1q_s32(noise));
+        int16x4_t hi = dithered4(vld1q_f32(in + i + 4), vld1q_s32(noise + 4));
+        vst1q_s16(out + i, vcombine_s16(lo, hi));
+    }
+    reference::floatToS16Dithered(in + i, out + i, count - i, rng);
+}
+
+#elif defined(__SSE2__)
+
+const char* kernelName() { return "SSE2"; }
+
+namespace {
+
+inline __m128 clampUnit4(__m128 x) {
+    return _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+}
+
+inline __m128i s16x4(__m128 x) {
+    return _mm_cvttps_epi32(_mm_mul_ps(clampUnit4(x), _mm_set1_ps(S16_SCALE)));
+}
+
+inline __m128i s32x4(__m128 x) {
+    return _mm_cvttps_epi32(_mm_min_ps(_mm_mul_ps(clampUnit4(x), _mm_set1_ps(S32_SCALE)), _mm_set1_ps(S32_MAX)));
+}
+
+inline __m128i dithered4(__m128 x, const int32_t* noise) {
+    __m128i v = _mm_cvttps_epi32(_mm_mul_ps(clampUnit4(x), _mm_set1_ps(DITHER_SCALE)));
+    v = _mm_add_epi32(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(noise)));
+    return _mm_srai_epi32(v, DITHER_FRACTION_BITS);
+}
+
+} // namespace
+
+void floatToS16(const float* in, int16_t* out, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i packed = _mm_packs_epi32(s16x4(_mm_loadu_ps(in + i)), s16x4(_mm_loadu_ps(in + i + 4)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+    }
+    reference::floatToS16(in + i, out + i, count - i);
+}
+
+void floatToS32(const float* in, int32_t* out, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), s32x4(_mm_loadu_ps(in + i)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), s32x4(_mm_loadu_ps(in + i + 4)));
+    }
+    reference::floatToS32(in + i, out + i, count - i);
+}
+
+void floatToS16Dithered(const float* in, int16_t* out, int count, Random& rng) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        int32_t noise[8];
+        for (int32_t& n : noise) {
+            n = ditherNoise(rng);
+        }
+        __m128i lo = dithered4(_mm_loadu_ps(in + i), noise);
+        __m128i hi = dithered4(_mm_loadu_ps(in + i + 4), noise + 4);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(lo, hi));  // Saturates
+    }
+    reference::floatToS16Dithered(in + i, out + i, count - i, rng);
+}
+
+#else
+
+const char* kernelName() { return "scalar"; }
+
+void floatToS16(const float* in, int16_t* out, int count) {
+    reference::floatToS16(in, out, count);
+}
+
+void floatToS32(const float* in, int32_t* out, int count) {
+    reference::floatToS32(in, out, count);
+}
+
+void floatToS16Dithered(const float* in, int16_t* out, int count, Random& rng) {
+    reference::floatToS16Dithered(in, out, count, rng);
+}
+
+#endif
+
+} // namespace sampleconv
+} // namespace phj
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include "../../dsp/random.h"
+
+namespace phj {
+
+/**
+ * Sample conversion kernels for the audio output path
+ *
+ * Convert interleaved float samples (the synth's output) to the device's
+ * integer format in a single pass: S32_LE or S16_LE, with optional TPDF
+ * dither for S16. FLOAT_LE devices take the synth's output as is. The
+ * kernels use NEON on ARM and SSE2 on x86 (selected at compile time, scalar
+ * otherwise); the scalar versions in sampleconv::reference define the exact
+ * output and the SIMD kernels match them bit for bit
+ * (tests/test_sample_convert.cpp).
+ *
+ * Conversion rules:
+ * - Input is clamped to [-1, 1]; integer results are truncated toward zero
+ * - S16: x * 32767
+ * - S32: x * 2^31, with the top clamped to the largest float below 2^31
+ *   (2147483520) so full scale can't wrap around to INT32_MIN
+ * - S16 dithered: x * 32767 plus triangular (TPDF) noise of +-1 LSB,
+ *   rounded to nearest (in fixed point, so it is exact under -ffast-math)
+ */
+namespace sampleconv {
+
+// Name of the compiled-in kernel set ("NEON", "SSE2" or "scalar")
+const char* kernelName();
+
+// count is in samples (2 per stereo frame); in and out may not overlap
+void floatToS16(const float* in, int16_t* out, int count);
+void floatToS32(const float* in, int32_t* out, int count);
+
+// Dither noise is drawn from rng, one value per sample in order
+void floatToS16Dithered(const float* in, int16_t* out, int count, Random& rng);
+
+namespace reference {
+
+void floatToS16(const float* in, int16_t* out, int count);
+void floatToS32(const float* in, int32_t* out, int count);
+void floatToS16Dithered(const float* in, int16_t* out, int count, Random& rng);
+
+} // namespace reference
+
+} // namespace sampleconv
+
+} // namespace phj
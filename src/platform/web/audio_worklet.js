@@ -40,6 +40,11 @@ class SynthProcessor extends AudioWorkletProcessor {
                 }
                 break;
 
+            // Any parameter by ParamId (src/dsp/param_registry.h), plain units
+            case 'setParam':
+                synthInstance.setParamValue(data.id, data.value);
+                break;
+
             // DCO parameters
             case 'setSawLevel':
                 synthInstance.setSawLevel(data);
@@ -156,9 +161,10 @@ class SynthProcessor extends AudioWorkletProcessor {
             // Create synth instance
             synthInstance = new wasmModule.WebSynth(sampleRate);
 
-            // Allocate buffers in WASM heap
-            this.leftPtr = wasmModule._malloc(this.bufferSize * 4);  // 4 bytes per float
-            this.rightPtr = wasmModule._malloc(this.bufferSize * 4);
+            // Allocate both channels as one block in the WASM heap
+            this.leftPtr = wasmModule._malloc(this.bufferSize * 2 * 4);  // 4 bytes per float
+            this.rightPtr = this.leftPtr + this.bufferSize * 4;
+            this.heapViews = null;  // Created on first use (see getHeapViews)
 
             this.port.postMessage({ type: 'initialized' });
         } catch (error) {
@@ -167,6 +173,23 @@ class SynthProcessor extends AudioWorkletProcessor {
         }
     }
 
+    // Float32Array views of the output block, kept across process() calls.
+    // They are rebuilt only when the quantum size changes or the WASM memory
+    // grows (which replaces HEAPF32.buffer), so the audio callback does not
+    // allocate two new views every 128 frames.
+    getHeapViews(numSamples) {
+        const buffer = wasmModule.HEAPF32.buffer;
+        if (!this.heapViews || this.heapViews.buffer !== buffer ||
+            this.heapViews.left.length !== numSamples) {
+            this.heapViews = {
+                buffer,
+                left: new Float32Array(buffer, this.leftPtr, numSamples),
+                right: new Float32Array(buffer, this.rightPtr, numSamples)
+            };
+        }
+        return this.heapViews;
+    }
+
     process(inputs, outputs, parameters) {
         if (!synthInstance) {
             // Not initialized yet, output silence
@@ -181,19 +204,9 @@ class SynthProcessor extends AudioWorkletProcessor {
         synthInstance.process(this.leftPtr, this.rightPtr, leftChannel.length);
 
         // Copy from WASM heap to output buffers
-        const leftHeap = new Float32Array(
-            wasmModule.HEAPF32.buffer,
-            this.leftPtr,
-            leftChannel.length
-        );
-        const rightHeap = new Float32Array(
-            wasmModule.HEAPF32.buffer,
-            this.rightPtr,
-            rightChannel.length
-        );
-
-        leftChannel.set(leftHeap);
-        rightChannel.set(rightHeap);
+        const views = this.getHeapViews(leftChannel.length);
+        leftChannel.set(views.left);
+        rightChannel.set(views.right);
 
         return true;
     }
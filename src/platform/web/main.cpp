@@ -2,6 +2,7 @@
 #include <emscripten/val.h>
 #include "../../dsp/synth.h"
 #include "../../dsp/parameters.h"
+#include "../../dsp/param_registry.h"
 #include "../../dsp/types.h"
 
 using namespace emscripten;
@@ -19,62 +20,69 @@ public:
         synth_.setSampleRate(sampleRate);
 
         // Default DCO parameters - sawtooth wave
-        dcoParams_.sawLevel = 0.5f;
-        dcoParams_.pulseLevel = 0.0f;
-        dcoParams_.subLevel = 0.0f;
-        dcoParams_.noiseLevel = 0.0f;
-        dcoParams_.pulseWidth = 0.5f;
-        dcoParams_.pwmDepth = 0.0f;
-        dcoParams_.lfoTarget = DcoParams::LFO_OFF;
-        dcoParams_.detune = 0.0f;
-        dcoParams_.enableDrift = true;
-        synth_.setDcoParameters(dcoParams_);
+        DcoParams dcoParams;
+        dcoParams.sawLevel = 0.5f;
+        dcoParams.pulseLevel = 0.0f;
+        dcoParams.subLevel = 0.0f;
+        dcoParams.noiseLevel = 0.0f;
+        dcoParams.pulseWidth = 0.5f;
+        dcoParams.pwmDepth = 0.0f;
+        dcoParams.lfoTarget = DcoParams::LFO_OFF;
+        dcoParams.detune = 0.0f;
+        dcoParams.enableDrift = true;
+        synth_.setDcoParameters(dcoParams);
 
         // Default filter parameters
-        filterParams_.cutoff = 0.8f;  // Start fairly open
-        filterParams_.resonance = 0.0f;
-        filterParams_.envAmount = 0.0f;
-        filterParams_.lfoAmount = 0.0f;
-        filterParams_.keyTrack = FilterParams::KEY_TRACK_OFF;
-        filterParams_.drive = 1.0f;
-        filterParams_.hpfMode = 0;  // M11: HPF off by default
-        synth_.setFilterParameters(filterParams_);
+        FilterParams filterParams;
+        filterParams.cutoff = 0.8f;  // Start fairly open
+        filterParams.resonance = 0.0f;
+        filterParams.envAmount = 0.0f;
+        filterParams.lfoAmount = 0.0f;
+        filterParams.keyTrack = FilterParams::KEY_TRACK_OFF;
+        filterParams.drive = 1.0f;
+        filterParams.hpfMode = 0;  // M11: HPF off by default
+        synth_.setFilterParameters(filterParams);
 
         // Default filter envelope parameters
-        filterEnvParams_.attack = 0.01f;
-        filterEnvParams_.decay = 0.3f;
-        filterEnvParams_.sustain = 0.7f;
-        filterEnvParams_.release = 0.5f;
-        synth_.setFilterEnvParameters(filterEnvParams_);
+        EnvelopeParams filterEnvParams;
+        filterEnvParams.attack = 0.01f;
+        filterEnvParams.decay = 0.3f;
+        filterEnvParams.sustain = 0.7f;
+        filterEnvParams.release = 0.5f;
+        synth_.setFilterEnvParameters(filterEnvParams);
 
         // Default amplitude envelope parameters
-        ampEnvParams_.attack = 0.005f;   // Fast attack for plucky sounds
-        ampEnvParams_.decay = 0.3f;
-        ampEnvParams_.sustain = 0.8f;
-        ampEnvParams_.release = 0.3f;
-        synth_.setAmpEnvParameters(ampEnvParams_);
+        EnvelopeParams ampEnvParams;
+        ampEnvParams.attack = 0.005f;   // Fast attack for plucky sounds
+        ampEnvParams.decay = 0.3f;
+        ampEnvParams.sustain = 0.8f;
+        ampEnvParams.release = 0.3f;
+        synth_.setAmpEnvParameters(ampEnvParams);
 
         // Default LFO parameters
-        lfoParams_.rate = 2.0f;
-        lfoParams_.delay = 0.0f;  // M12
-        synth_.setLfoParameters(lfoParams_);
+        LfoParams lfoParams;
+        lfoParams.rate = 2.0f;
+        lfoParams.delay = 0.0f;  // M12
+        synth_.setLfoParameters(lfoParams);
 
         // Default chorus parameters (off by default)
-        chorusParams_.mode = 0;  // OFF
-        synth_.setChorusParameters(chorusParams_);
+        ChorusParams chorusParams;
+        chorusParams.mode = 0;  // OFF
+        synth_.setChorusParameters(chorusParams);
 
         // M11/M13/M14: Default performance parameters
-        performanceParams_.pitchBend = 0.0f;
-        performanceParams_.pitchBendRange = 2.0f;
-        performanceParams_.portamentoTime = 0.0f;
-        performanceParams_.modWheel = 1.0f;  // M13: Default to full modulation
-        performanceParams_.vcaMode = PerformanceParams::VCA_ENV;  // M13: Default to envelope mode
-        performanceParams_.filterEnvPolarity = PerformanceParams::FILTER_ENV_NORMAL;  // M13: Default to normal
-        performanceParams_.vcaLevel = 0.8f;  // M14: Default VCA level
-        performanceParams_.masterTune = 0.0f;  // M14: Default to no tuning offset
-        performanceParams_.velocityToFilter = 0.0f;  // M14: Default to no velocity sensitivity
-        performanceParams_.velocityToAmp = 1.0f;  // M14: Default to full velocity to amp
-        synth_.setPerformanceParameters(performanceParams_);
+        PerformanceParams performanceParams;
+        performanceParams.pitchBend = 0.0f;
+        performanceParams.pitchBendRange = 2.0f;
+        performanceParams.portamentoTime = 0.0f;
+        performanceParams.modWheel = 1.0f;  // M13: Default to full modulation
+        performanceParams.vcaMode = PerformanceParams::VCA_ENV;  // M13: Default to envelope mode
+        performanceParams.filterEnvPolarity = PerformanceParams::FILTER_ENV_NORMAL;  // M13: Default to normal
+        performanceParams.vcaLevel = 0.8f;  // M14: Default VCA level
+        performanceParams.masterTune = 0.0f;  // M14: Default to no tuning offset
+        performanceParams.velocityToFilter = 0.0f;  // M14: Default to no velocity sensitivity
+        performanceParams.velocityToAmp = 1.0f;  // M14: Default to full velocity to amp
+        synth_.setPerformanceParameters(performanceParams);
     }
 
     // Process audio (called from AudioWorklet)
@@ -107,199 +115,175 @@ public:
         }
     }
 
-    // Parameter control - DCO
+    // Generic parameter access (ids and ranges in param_registry.h)
+    void setParam(int id, float normalized) {
+        synth_.setParam(static_cast<ParamId>(id), normalized);
+    }
+
+    void setParamValue(int id, float value) {
+        synth_.setParamValue(static_cast<ParamId>(id), value);
+    }
+
+    float getParamValue(int id) const {
+        return synth_.getParamValue(static_cast<ParamId>(id));
+    }
+
+    // Parameter control (plain units, clamped to the registry range) - DCO
     void setSawLevel(float level) {
-        dcoParams_.sawLevel = level;
-        synth_.setDcoParameters(dcoParams_);
+        synth_.setParamValue(ParamId::DCO_SAW_LEVEL, level);
     }
 
     void setPulseLevel(float level) {
-        dcoParams_.pulseLevel = level;
-        synth_.setDcoParameters(dcoParams_);
+        synth_.setParamValue(ParamId::DCO_PULSE_LEVEL, level);
     }
 
     void setSubLevel(float level) {
-        dcoParams_.subLevel = level;
-        synth_.setDcoParameters(dcoParams_);
+        synth_.setParamValue(ParamId::DCO_SUB_LEVEL, level);
     }
 
     void setNoiseLevel(float level) {
-        dcoParams_.noiseLevel = level;
-        synth_.setDcoParameters(dcoParams_);
+        synth_.setParamValue(ParamId::DCO_NOISE_LEVEL, level);
     }
 
     void setPulseWidth(float width) {
-        dcoParams_.pulseWidth = width;
-        synth_.setDcoParameters(dcoParams_);
+        synth_.setParamValue(ParamId::DCO_PULSE_WIDTH, width);
     }
 
     void setPwmDepth(float depth) {
-        dcoParams_.pwmDepth = depth;
-        synth_.setDcoParameters(dcoParams_);
+        synth_.setParamValue(ParamId::DCO_PWM_DEPTH, depth);
     }
 
     void setLfoTarget(int target) {
-        dcoParams_.lfoTarget = target;
-        synth_.setDcoParameters(dcoParams_);
+        synth_.setParamValue(ParamId::DCO_LFO_TARGET, static_cast<float>(target));
     }
 
     void setLfoRate(float rate) {
-        lfoParams_.rate = rate;
-        synth_.setLfoParameters(lfoParams_);
+        synth_.setParamValue(ParamId::LFO_RATE, rate);
     }
 
     void setLfoDelay(float delay) {
-        lfoParams_.delay = delay;
-        synth_.setLfoParameters(lfoParams_);
+        synth_.setParamValue(ParamId::LFO_DELAY, delay);
     }
 
     void setDetune(float cents) {
-        dcoParams_.detune = cents;
-        synth_.setDcoParameters(dcoParams_);
+        synth_.setParamValue(ParamId::DCO_DETUNE, cents);
     }
 
     void setDriftEnabled(bool enabled) {
-        dcoParams_.enableDrift = enabled;
-        synth_.setDcoParameters(dcoParams_);
+        synth_.setParamValue(ParamId::DCO_DRIFT, enabled ? 1.0f : 0.0f);
     }
 
     // Parameter control - Filter
     void setFilterCutoff(float cutoff) {
-        filterParams_.cutoff = cutoff;
-        synth_.setFilterParameters(filterParams_);
+        synth_.setParamValue(ParamId::FILTER_CUTOFF, cutoff);
     }
 
     void setFilterResonance(float resonance) {
-        filterParams_.resonance = resonance;
-        synth_.setFilterParameters(filterParams_);
+        synth_.setParamValue(ParamId::FILTER_RESONANCE, resonance);
     }
 
     void setFilterEnvAmount(float amount) {
-        filterParams_.envAmount = amount;
-        synth_.setFilterParameters(filterParams_);
+        synth_.setParamValue(ParamId::FILTER_ENV_AMOUNT, amount);
     }
 
     void setFilterLfoAmount(float amount) {
-        filterParams_.lfoAmount = amount;
-        synth_.setFilterParameters(filterParams_);
+        synth_.setParamValue(ParamId::FILTER_LFO_AMOUNT, amount);
     }
 
     void setFilterKeyTrack(int mode) {
-        filterParams_.keyTrack = mode;
-        synth_.setFilterParameters(filterParams_);
+        synth_.setParamValue(ParamId::FILTER_KEY_TRACK, static_cast<float>(mode));
     }
 
     // M11: HPF
     void setFilterHpfMode(int mode) {
-        filterParams_.hpfMode = mode;
-        synth_.setFilterParameters(filterParams_);
+        synth_.setParamValue(ParamId::FILTER_HPF_MODE, static_cast<float>(mode));
     }
 
     // Parameter control - Filter Envelope
     void setFilterEnvAttack(float attack) {
-        filterEnvParams_.attack = attack;
-        synth_.setFilterEnvParameters(filterEnvParams_);
+        synth_.setParamValue(ParamId::FILTER_ENV_ATTACK, attack);
     }
 
     void setFilterEnvDecay(float decay) {
-        filterEnvParams_.decay = decay;
-        synth_.setFilterEnvParameters(filterEnvParams_);
+        synth_.setParamValue(ParamId::FILTER_ENV_DECAY, decay);
     }
 
     void setFilterEnvSustain(float sustain) {
-        filterEnvParams_.sustain = sustain;
-        synth_.setFilterEnvParameters(filterEnvParams_);
+        synth_.setParamValue(ParamId::FILTER_ENV_SUSTAIN, sustain);
     }
 
     void setFilterEnvRelease(float release) {
-        filterEnvParams_.release = release;
-        synth_.setFilterEnvParameters(filterEnvParams_);
+        synth_.setParamValue(ParamId::FILTER_ENV_RELEASE, release);
     }
 
     // Parameter control - Amplitude Envelope
     void setAmpEnvAttack(float attack) {
-        ampEnvParams_.attack = attack;
-        synth_.setAmpEnvParameters(ampEnvParams_);
+        synth_.setParamValue(ParamId::AMP_ENV_ATTACK, attack);
     }
 
     void setAmpEnvDecay(float decay) {
-        ampEnvParams_.decay = decay;
-        synth_.setAmpEnvParameters(ampEnvParams_);
+        synth_.setParamValue(ParamId::AMP_ENV_DECAY, decay);
     }
 
     void setAmpEnvSustain(float sustain) {
-        ampEnvParams_.sustain = sustain;
-        synth_.setAmpEnvParameters(ampEnvParams_);
+        synth_.setParamValue(ParamId::AMP_ENV_SUSTAIN, sustain);
     }
 
     void setAmpEnvRelease(float release) {
-        ampEnvParams_.release = release;
-        synth_.setAmpEnvParameters(ampEnvParams_);
+        synth_.setParamValue(ParamId::AMP_ENV_RELEASE, release);
     }
 
     // Parameter control - Chorus
     void setChorusMode(int mode) {
-        chorusParams_.mode = mode;
-        synth_.setChorusParameters(chorusParams_);
+        synth_.setParamValue(ParamId::CHORUS_MODE, static_cast<float>(mode));
     }
 
     // M11: Performance parameters
     void setPitchBendRange(float semitones) {
-        performanceParams_.pitchBendRange = semitones;
-        synth_.setPerformanceParameters(performanceParams_);
+        synth_.setParamValue(ParamId::PITCH_BEND_RANGE, semitones);
     }
 
     void setPortamentoTime(float seconds) {
-        performanceParams_.portamentoTime = seconds;
-        synth_.setPerformanceParameters(performanceParams_);
+        synth_.setParamValue(ParamId::PORTAMENTO_TIME, seconds);
     }
 
     // M13: Performance parameters
     void setModWheel(float value) {
-        performanceParams_.modWheel = value;
-        synth_.setPerformanceParameters(performanceParams_);
+        synth_.setParamValue(ParamId::MOD_WHEEL, value);
     }
 
     void setVcaMode(int mode) {
-        performanceParams_.vcaMode = mode;
-        synth_.setPerformanceParameters(performanceParams_);
+        synth_.setParamValue(ParamId::VCA_MODE, static_cast<float>(mode));
     }
 
     void setFilterEnvPolarity(int polarity) {
-        performanceParams_.filterEnvPolarity = polarity;
-        synth_.setPerformanceParameters(performanceParams_);
+        synth_.setParamValue(ParamId::FILTER_ENV_POLARITY, static_cast<float>(polarity));
     }
 
     // M14: Range & Voice Control
     void setDcoRange(int range) {
-        dcoParams_.range = range;
-        synth_.setDcoParameters(dcoParams_);
+        synth_.setParamValue(ParamId::DCO_RANGE, static_cast<float>(range));
     }
 
     void setVcaLevel(float level) {
-        performanceParams_.vcaLevel = level;
-        synth_.setPerformanceParameters(performanceParams_);
+        synth_.setParamValue(ParamId::VCA_LEVEL, level);
     }
 
     void setMasterTune(float cents) {
-        performanceParams_.masterTune = cents;
-        synth_.setPerformanceParameters(performanceParams_);
+        synth_.setParamValue(ParamId::MASTER_TUNE, cents);
     }
 
     void setVelocityToFilter(float amount) {
-        performanceParams_.velocityToFilter = amount;
-        synth_.setPerformanceParameters(performanceParams_);
+        synth_.setParamValue(ParamId::VELOCITY_TO_FILTER, amount);
     }
 
     void setVelocityToAmp(float amount) {
-        performanceParams_.velocityToAmp = amount;
-        synth_.setPerformanceParameters(performanceParams_);
+        synth_.setParamValue(ParamId::VELOCITY_TO_AMP, amount);
     }
 
     // M16: Voice Allocation Mode
     void setVoiceAllocationMode(int mode) {
-        performanceParams_.voiceAllocationMode = mode;
-        synth_.setPerformanceParameters(performanceParams_);
+        synth_.setParamValue(ParamId::VOICE_ALLOCATION_MODE, static_cast<float>(mode));
     }
 
     // Legacy interface for compatibility (deprecated, but kept for backward compat)
@@ -314,20 +298,15 @@ public:
 private:
     float sampleRate_;
     Synth synth_;
-
-    DcoParams dcoParams_;
-    FilterParams filterParams_;
-    EnvelopeParams filterEnvParams_;
-    EnvelopeParams ampEnvParams_;
-    LfoParams lfoParams_;
-    ChorusParams chorusParams_;
-    PerformanceParams performanceParams_;  // M11
 };
 
 // Emscripten bindings
 EMSCRIPTEN_BINDINGS(synth_module) {
     class_<WebSynth>("WebSynth")
         .constructor<float>()
+        .function("setParam", &WebSynth::setParam)
+        .function("setParamValue", &WebSynth::setParamValue)
+        .function("getParamValue", &WebSynth::getParamValue)
         .function("process", &WebSynth::process)
         .function("handleMidi", &WebSynth::handleMidi)
 
@@ -0,0 +1,83 @@
+/**
+ * Unit tests for the memory-mapped patch bank file
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include "bank_file.h"
+
+using namespace phj;
+
+namespace {
+
+std::string tempPath(const char* name) {
+    return "/tmp/phj_test_" + std::to_string(getpid()) + "_" + name;
+}
+
+} // namespace
+
+TEST_CASE("BankFile maps a written bank", "[bank_file]") {
+    const std::string path = tempPath("bank.phb");
+    PatchRecord records[BANK_SIZE];
+    for (int i = 0; i < BANK_SIZE; ++i) {
+        Patch patch;
+        patch.filter.cutoff = i / 127.0f;
+        encodePatch(patch, ("Patch " + std::to_string(i)).c_str(), records[i]);
+    }
+    REQUIRE(BankFile::write(path, records, BANK_SIZE));
+
+    BankFile bank;
+    REQUIRE_FALSE(bank.isOpen());
+    REQUIRE(bank.open(path));
+    REQUIRE(bank.isOpen());
+    REQUIRE(bank.getCount() == BANK_SIZE);
+
+    for (int program : {0, 1, 64, 127}) {
+        const PatchRecord* record = bank.getRecord(program);
+        REQUIRE(record != nullptr);
+        REQUIRE(std::string(record->name) == "Patch " + std::to_string(program));
+        REQUIRE(decodePatch(*record).filter.cutoff == records[program].cutoff);
+    }
+    REQUIRE(bank.getRecord(-1) == nullptr);
+    REQUIRE(bank.getRecord(BANK_SIZE) == nullptr);
+
+    SECTION("Rewriting the file leaves the open mapping intact") {
+        Patch patch;
+        patch.filter.cutoff = 1.0f;
+        encodePatch(patch, "New", records[0]);
+        REQUIRE(BankFile::write(path, records, 1));
+        REQUIRE(std::string(bank.getRecord(0)->name) == "Patch 0");
+
+        BankFile reopened;
+        REQUIRE(reopened.open(path));
+        REQUIRE(reopened.getCount() == 1);
+        REQUIRE(std::string(reopened.getRecord(0)->name) == "New");
+    }
+
+    bank.close();
+    REQUIRE_FALSE(bank.isOpen());
+    REQUIRE(bank.getRecord(0) == nullptr);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("BankFile rejects files that are not banks", "[bank_file]") {
+    BankFile bank;
+    REQUIRE_FALSE(bank.open(tempPath("missing.phb")));
+
+    const std::string path = tempPath("garbage.phb");
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "This is not a patch bank, just some text.";
+    }
+    REQUIRE_FALSE(bank.open(path));
+    REQUIRE_FALSE(bank.isOpen());
+    std::remove(path.c_str());
+
+    PatchRecord record;
+    encodePatch(Patch(), "Init", record);
+    REQUIRE_FALSE(BankFile::write(path, &record, 0));
+    REQUIRE_FALSE(BankFile::write(path, &record, BANK_SIZE + 1));
+}
@@ -1,9 +1,12 @@
 /**
  * Unit tests for Chorus (BBD Stereo Chorus)
+ *
+ * Benchmarks are hidden; run them with: phj_tests "[benchmark]"
  */
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <algorithm>
 #include <cmath>
 #include <vector>
@@ -565,3 +568,131 @@ TEST_CASE("Chorus sample rate handling", "[chorus]") {
         // This just verifies the chorus adapts to different sample rates
     }
 }
+
+TEST_CASE("Chorus block processing", "[chorus]") {
+    std::vector<Sample> input(2000);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = std::sin(i * 0.03f) * 0.7f;
+    }
+
+    SECTION("Block and per-sample processing match") {
+        for (int mode = Chorus::MODE_I; mode <= Chorus::MODE_BOTH; ++mode) {
+            Chorus block;
+            Chorus single;
+            block.setSampleRate(48000.0f);
+            single.setSampleRate(48000.0f);
+            block.setMode(static_cast<Chorus::Mode>(mode));
+            single.setMode(static_cast<Chorus::Mode>(mode));
+
+            std::vector<Sample> left(input.size());
+            std::vector<Sample> right(input.size());
+            block.process(input.data(), left.data(), right.data(), static_cast<int>(input.size()));
+
+            for (size_t i = 0; i < input.size(); ++i) {
+                Sample l, r;
+                single.process(input[i], l, r);
+                REQUIRE_THAT(l, WithinAbs(left[i], 1e-6f));
+                REQUIRE_THAT(r, WithinAbs(right[i], 1e-6f));
+            }
+        }
+    }
+
+    SECTION("Delay line tail decays to silence and resumes cleanly") {
+        Chorus chorus;
+        chorus.setSampleRate(48000.0f);
+        chorus.setMode(Chorus::MODE_BOTH);
+
+        std::vector<Sample> left(256);
+        std::vector<Sample> right(256);
+        chorus.process(input.data(), left.data(), right.data(), 256);
+
+        // Silence: the wet tail is still audible right after the input stops
+        std::vector<Sample> silence(256, 0.0f);
+        chorus.process(silence.data(), left.data(), right.data(), 256);
+        float tailPeak = 0.0f;
+        for (Sample s : left) {
+            tailPeak = std::max(tailPeak, std::abs(s));
+        }
+        REQUIRE(tailPeak > 0.01f);
+
+        // ...and exactly silent once the delay line has flushed
+        for (int block = 0; block < 10; ++block) {
+            chorus.process(silence.data(), left.data(), right.data(), 256);
+        }
+        for (size_t i = 0; i < left.size(); ++i) {
+            REQUIRE(left[i] == 0.0f);
+            REQUIRE(right[i] == 0.0f);
+        }
+
+        // New input is processed again (dry signal plus fresh wet taps)
+        chorus.process(input.data(), left.data(), right.data(), 256);
+        REQUIRE_THAT(left[10], WithinAbs(0.8f * input[10], 1e-6f));
+        REQUIRE(std::abs(left[255] - 0.8f * input[255]) > 0.0f);
+    }
+
+    SECTION("Switching off drops the delay line tail") {
+        Chorus chorus;
+        chorus.setSampleRate(48000.0f);
+        chorus.setMode(Chorus::MODE_I);
+
+        std::vector<Sample> left(256);
+        std::vector<Sample> right(256);
+        chorus.process(input.data(), left.data(), right.data(), 256);
+        REQUIRE_FALSE(chorus.isIdle());
+
+        chorus.setMode(Chorus::OFF);
+        REQUIRE(chorus.isIdle());
+
+        // Back on with silent input: no stale wet signal
+        chorus.setMode(Chorus::MODE_I);
+        std::vector<Sample> silence(256, 0.0f);
+        chorus.process(silence.data(), left.data(), right.data(), 256);
+        for (size_t i = 0; i < left.size(); ++i) {
+            REQUIRE(left[i] == 0.0f);
+            REQUIRE(right[i] == 0.0f);
+        }
+    }
+
+    SECTION("Delays fit the buffer at high sample rates") {
+        Chorus chorus;
+        chorus.setSampleRate(192000.0f);
+        chorus.setMode(Chorus::MODE_BOTH);
+
+        // An impulse must come back after the Chorus II delay (~4 ms = 768 samples)
+        std::vector<Sample> impulse(2048, 0.0f);
+        impulse[0] = 1.0f;
+        std::vector<Sample> left(2048);
+        std::vector<Sample> right(2048);
+        chorus.process(impulse.data(), left.data(), right.data(), 2048);
+
+        float latePeak = 0.0f;
+        for (int i = 600; i < 1000; ++i) {
+            latePeak = std::max(latePeak, std::abs(left[i]));
+        }
+        REQUIRE(latePeak > 0.05f);
+    }
+}
+
+TEST_CASE("Chorus benchmarks", "[.][benchmark][chorus]") {
+    Chorus chorus;
+    chorus.setSampleRate(48000.0f);
+
+    std::vector<Sample> input(512);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = std::sin(i * 0.05f);
+    }
+    std::vector<Sample> left(512);
+    std::vector<Sample> right(512);
+
+    BENCHMARK("Mode I x512") {
+        chorus.setMode(Chorus::MODE_I);
+        chorus.process(input.data(), left.data(), right.data(), 512);
+        return left[511];
+    };
+
+    BENCHMARK("Mode I+II x512") {
+        chorus.setMode(Chorus::MODE_BOTH);
+        chorus.process(input.data(), left.data(), right.data(), 512);
+        return left[511];
+    };
+}
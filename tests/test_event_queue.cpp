@@ -0,0 +1,98 @@
+/**
+ * Unit tests for SpscQueue (MIDI thread -> audio thread event queue)
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <thread>
+#include "event_queue.h"
+
+using namespace phj;
+
+TEST_CASE("SpscQueue basic operation", "[event_queue]") {
+    SpscQueue<int, 8> queue;
+
+    SECTION("Starts empty") {
+        int value = -1;
+        REQUIRE(queue.empty());
+        REQUIRE(queue.peek() == nullptr);
+        REQUIRE_FALSE(queue.pop(value));
+        REQUIRE(value == -1);
+    }
+
+    SECTION("Items come out in order") {
+        for (int i = 0; i < 5; ++i) {
+            REQUIRE(queue.push(i));
+        }
+        REQUIRE_FALSE(queue.empty());
+        REQUIRE(*queue.peek() == 0);
+
+        int value;
+        for (int i = 0; i < 5; ++i) {
+            REQUIRE(queue.pop(value));
+            REQUIRE(value == i);
+        }
+        REQUIRE(queue.empty());
+    }
+
+    SECTION("All slots are usable and a full queue rejects pushes") {
+        for (int i = 0; i < 8; ++i) {
+            REQUIRE(queue.push(i));
+        }
+        REQUIRE_FALSE(queue.push(99));
+
+        int value;
+        REQUIRE(queue.pop(value));
+        REQUIRE(value == 0);
+        REQUIRE(queue.push(8));  // Room again after one pop
+    }
+
+    SECTION("Indices wrap around the buffer") {
+        int value;
+        for (int i = 0; i < 1000; ++i) {
+            REQUIRE(queue.push(i));
+            REQUIRE(queue.push(i + 1));
+            REQUIRE(queue.pop(value));
+            REQUIRE(value == i);
+            REQUIRE(queue.pop(value));
+            REQUIRE(value == i + 1);
+        }
+        REQUIRE(queue.empty());
+    }
+}
+
+TEST_CASE("SpscQueue across threads", "[event_queue]") {
+    // Producer and consumer run concurrently; every event must arrive once,
+    // in order and intact
+    constexpr uint32_t NUM_EVENTS = 200000;
+    SpscQueue<MidiEvent, 64> queue;
+
+    std::thread producer([&queue]() {
+        for (uint32_t i = 0; i < NUM_EVENTS; ++i) {
+            MidiEvent event = {i, static_cast<uint8_t>(0x90 | (i & 0x0F)),
+                               static_cast<uint8_t>(i & 0x7F), static_cast<uint8_t>((i >> 7) & 0x7F)};
+            while (!queue.push(event)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t received = 0;
+    bool intact = true;
+    MidiEvent event;
+    while (received < NUM_EVENTS) {
+        if (!queue.pop(event)) {
+            std::this_thread::yield();
+            continue;
+        }
+        const uint32_t i = received++;
+        intact = intact && event.timestamp == i &&
+                 event.status == (0x90 | (i & 0x0F)) &&
+                 event.data1 == (i & 0x7F) &&
+                 event.data2 == ((i >> 7) & 0x7F);
+    }
+    producer.join();
+
+    REQUIRE(intact);
+    REQUIRE(queue.empty());
+}
@@ -0,0 +1,109 @@
+/**
+ * Unit tests and benchmarks for the fast math kernels
+ *
+ * Benchmarks are hidden; run them with: phj_tests "[benchmark]"
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cmath>
+#include <vector>
+#include "fast_math.h"
+#include "types.h"
+
+using namespace phj;
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("fastExp2 accuracy", "[fastmath]") {
+    SECTION("Relative error is below 2e-7 over [-126, 127]") {
+        double maxError = 0.0;
+        for (int i = 0; i <= 2530000; ++i) {
+            float x = -126.0f + i * 0.0001f;
+            double reference = std::exp2(static_cast<double>(x));
+            double error = std::abs(fastExp2(x) - reference) / reference;
+            maxError = std::max(maxError, error);
+        }
+        REQUIRE(maxError < 2e-7);
+    }
+
+    SECTION("Integer powers are exact") {
+        for (int i = -126; i <= 127; ++i) {
+            REQUIRE(fastExp2(static_cast<float>(i)) == std::ldexp(1.0f, i));
+        }
+    }
+
+    SECTION("Out-of-range inputs are clamped") {
+        REQUIRE(fastExp2(-1000.0f) == std::ldexp(1.0f, -126));
+        REQUIRE(fastExp2(1000.0f) == std::ldexp(1.0f, 127));
+    }
+
+    SECTION("Pitch helpers match semitone and cent ratios") {
+        REQUIRE_THAT(semitonesToRatio(12.0f), WithinAbs(2.0f, 1e-6f));
+        REQUIRE_THAT(semitonesToRatio(-12.0f), WithinAbs(0.5f, 1e-6f));
+        REQUIRE_THAT(centsToRatio(100.0f), WithinAbs(std::pow(2.0f, 1.0f / 12.0f), 1e-6f));
+        REQUIRE_THAT(midiNoteToFrequency(69), WithinAbs(440.0f, 1e-4f));
+        REQUIRE_THAT(midiNoteToFrequency(60), WithinAbs(261.6256f, 1e-3f));
+    }
+}
+
+TEST_CASE("fastTan accuracy", "[fastmath]") {
+    SECTION("Relative error is below 2e-6 over the filter range [0, 0.49 pi]") {
+        double maxError = 0.0;
+        const int steps = 200000;
+        for (int i = 1; i <= steps; ++i) {
+            float x = i * (0.49f * PI / steps);
+            double reference = std::tan(static_cast<double>(x));
+            double error = std::abs(fastTan(x) - reference) / reference;
+            maxError = std::max(maxError, error);
+        }
+        REQUIRE(maxError < 2e-6);
+    }
+
+    SECTION("tan is monotonic across the pi/4 split") {
+        float previous = 0.0f;
+        for (int i = 1; i < 10000; ++i) {
+            float x = i * (0.49f * PI / 10000.0f);
+            float value = fastTan(x);
+            REQUIRE(value >= previous);
+            previous = value;
+        }
+    }
+
+    SECTION("Edge inputs stay finite") {
+        REQUIRE(fastTan(0.0f) == 0.0f);
+        REQUIRE(fastTan(-1.0f) == 0.0f);
+        REQUIRE(std::isfinite(fastTan(PI * 0.5f)));
+    }
+}
+
+TEST_CASE("Fast math benchmarks", "[.][benchmark][fastmath]") {
+    std::vector<float> inputs(1024);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        inputs[i] = static_cast<float>(i) / inputs.size();
+    }
+
+    BENCHMARK("std::pow(2, x) x1024") {
+        float sum = 0.0f;
+        for (float x : inputs) sum += std::pow(2.0f, x * 4.0f);
+        return sum;
+    };
+
+    BENCHMARK("fastExp2(x) x1024") {
+        float sum = 0.0f;
+        for (float x : inputs) sum += fastExp2(x * 4.0f);
+        return sum;
+    };
+
+    BENCHMARK("std::tan(x) x1024") {
+        float sum = 0.0f;
+        for (float x : inputs) sum += std::tan(x * 1.5f);
+        return sum;
+    };
+
+    BENCHMARK("fastTan(x) x1024") {
+        float sum = 0.0f;
+        for (float x : inputs) sum += fastTan(x * 1.5f);
+        return sum;
+    };
+}
@@ -523,3 +523,123 @@ TEST_CASE("Filter velocity modulation (M14)", "[filter][m14]") {
         REQUIRE(identical);
     }
 }
+
+namespace {
+
+// Saw through the filter with a decaying envelope sweep on the cutoff
+std::vector<Sample> renderEnvelopeSweep(int coefficientInterval, float resonance) {
+    const int numSamples = 4096;
+
+    Filter filter;
+    filter.setSampleRate(48000.0f);
+    filter.setCoefficientInterval(coefficientInterval);
+
+    FilterParams params;
+    params.cutoff = 0.3f;
+    params.resonance = resonance;
+    params.envAmount = 0.8f;
+    filter.setParameters(params);
+    filter.reset();
+
+    std::vector<Sample> output(numSamples);
+    float phase = 0.0f;
+    for (int i = 0; i < numSamples; ++i) {
+        filter.setEnvValue(std::exp(-i / 1500.0f));
+        output[i] = filter.process(2.0f * phase - 1.0f);
+        phase += 220.0f / 48000.0f;
+        if (phase >= 1.0f) phase -= 1.0f;
+    }
+    return output;
+}
+
+// Hann-windowed DFT magnitude spectrum
+std::vector<double> magnitudeSpectrum(const std::vector<Sample>& signal) {
+    const int n = static_cast<int>(signal.size());
+    std::vector<double> magnitude(n / 2);
+    for (int k = 0; k < n / 2; ++k) {
+        double re = 0.0;
+        double im = 0.0;
+        for (int i = 0; i < n; ++i) {
+            double window = 0.5 - 0.5 * std::cos(2.0 * M_PI * i / (n - 1));
+            double angle = 2.0 * M_PI * k * i / n;
+            re += window * signal[i] * std::cos(angle);
+            im -= window * signal[i] * std::sin(angle);
+        }
+        magnitude[k] = std::sqrt(re * re + im * im);
+    }
+    return magnitude;
+}
+
+// Energy of the magnitude-spectrum difference relative to the reference (dB)
+double spectralErrorDb(const std::vector<Sample>& reference, const std::vector<Sample>& test) {
+    std::vector<double> refSpectrum = magnitudeSpectrum(reference);
+    std::vector<double> testSpectrum = magnitudeSpectrum(test);
+
+    double errorEnergy = 0.0;
+    double refEnergy = 0.0;
+    for (size_t k = 0; k < refSpectrum.size(); ++k) {
+        double diff = refSpectrum[k] - testSpectrum[k];
+        errorEnergy += diff * diff;
+        refEnergy += refSpectrum[k] * refSpectrum[k];
+    }
+    return 10.0 * std::log10(errorEnergy / refEnergy);
+}
+
+} // namespace
+
+TEST_CASE("Filter control-rate coefficients", "[filter]") {
+    SECTION("Unmodulated filter matches the per-sample path exactly") {
+        Filter perSample;
+        Filter controlRate;
+        controlRate.setCoefficientInterval(32);
+
+        FilterParams params;
+        params.cutoff = 0.45f;
+        params.resonance = 0.5f;
+        perSample.setParameters(params);
+        controlRate.setParameters(params);
+        perSample.reset();
+        controlRate.reset();
+
+        for (int i = 0; i < 1000; ++i) {
+            Sample input = (i % 64) < 32 ? 0.5f : -0.5f;
+            REQUIRE(controlRate.process(input) == perSample.process(input));
+        }
+    }
+
+    SECTION("Spectral error of an envelope sweep is bounded") {
+        std::vector<Sample> reference = renderEnvelopeSweep(1, 0.5f);
+
+        REQUIRE(spectralErrorDb(reference, renderEnvelopeSweep(16, 0.5f)) < -38.0);
+        REQUIRE(spectralErrorDb(reference, renderEnvelopeSweep(32, 0.5f)) < -32.0);
+    }
+
+    SECTION("Cutoff changes are ramped over one interval") {
+        FilterParams params;
+        params.cutoff = 0.2f;
+
+        Filter filter;
+        filter.setCoefficientInterval(16);
+        filter.setParameters(params);
+        filter.reset();
+        float startG = filter.getCutoffCoefficient();
+
+        // Reference coefficient for the new cutoff
+        params.cutoff = 0.6f;
+        Filter reference;
+        reference.setParameters(params);
+        reference.reset();
+        float targetG = reference.getCutoffCoefficient();
+
+        filter.setParameters(params);
+        filter.process(0.0f);
+        float firstG = filter.getCutoffCoefficient();
+        REQUIRE(firstG > startG);
+        REQUIRE(firstG < targetG);
+
+        for (int i = 1; i < 16; ++i) {
+            filter.process(0.0f);
+        }
+        REQUIRE_THAT(filter.getCutoffCoefficient(), WithinAbs(targetG, 1e-5f));
+    }
+}
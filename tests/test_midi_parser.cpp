@@ -0,0 +1,243 @@
+/**
+ * Unit tests for MidiParser (raw MIDI byte stream -> events)
+ *
+ * Benchmarks are hidden; run them with: phj_tests "[benchmark]"
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <algorithm>
+#include <vector>
+#include "midi_parser.h"
+#include "random.h"
+
+using namespace phj;
+
+namespace {
+
+std::vector<MidiEvent> parseAll(MidiParser& parser, const std::vector<uint8_t>& bytes) {
+    std::vector<MidiEvent> events;
+    MidiEvent event;
+    for (uint8_t byte : bytes) {
+        if (parser.processByte(byte, 0, event)) {
+            events.push_back(event);
+        }
+    }
+    return events;
+}
+
+bool sameEvent(const MidiEvent& a, const MidiEvent& b) {
+    return a.status == b.status && a.data1 == b.data1 && a.data2 == b.data2;
+}
+
+} // namespace
+
+TEST_CASE("MidiParser messages", "[midi_parser]") {
+    MidiParser parser;
+
+    SECTION("Several messages in one chunk are all reported") {
+        auto events = parseAll(parser, {0x90, 60, 100, 0x91, 64, 90, 0xB0, 74, 20, 0xE0, 0x00, 0x40});
+        REQUIRE(events.size() == 4);
+        REQUIRE(sameEvent(events[0], {0, 0x90, 60, 100}));
+        REQUIRE(sameEvent(events[1], {0, 0x91, 64, 90}));
+        REQUIRE(sameEvent(events[2], {0, 0xB0, 74, 20}));
+        REQUIRE(sameEvent(events[3], {0, 0xE0, 0x00, 0x40}));
+    }
+
+    SECTION("Running status repeats the last channel status") {
+        auto events = parseAll(parser, {0x90, 60, 100, 64, 100, 67, 0});
+        REQUIRE(events.size() == 3);
+        REQUIRE(sameEvent(events[1], {0, 0x90, 64, 100}));
+        REQUIRE(sameEvent(events[2], {0, 0x90, 67, 0}));
+    }
+
+    SECTION("Messages split across chunks") {
+        MidiEvent event;
+        REQUIRE_FALSE(parser.processByte(0xB0, 0, event));
+        REQUIRE_FALSE(parser.processByte(7, 0, event));
+        REQUIRE(parser.processByte(100, 42, event));
+        REQUIRE(sameEvent(event, {0, 0xB0, 7, 100}));
+        REQUIRE(event.timestamp == 42);
+    }
+
+    SECTION("One data byte messages") {
+        auto events = parseAll(parser, {0xC2, 5, 6, 0xD0, 90});
+        REQUIRE(events.size() == 3);
+        REQUIRE(sameEvent(events[0], {0, 0xC2, 5, 0}));
+        REQUIRE(sameEvent(events[1], {0, 0xC2, 6, 0}));  // Running status
+        REQUIRE(sameEvent(events[2], {0, 0xD0, 90, 0}));
+    }
+
+    SECTION("Realtime bytes inside a message do not disturb it") {
+        auto events = parseAll(parser, {0x90, 0xF8, 60, 0xFE, 100, 0xF8, 62, 80});
+        REQUIRE(events.size() == 5);
+        REQUIRE(sameEvent(events[0], {0, 0xF8, 0, 0}));
+        REQUIRE(sameEvent(events[1], {0, 0xFE, 0, 0}));
+        REQUIRE(sameEvent(events[2], {0, 0x90, 60, 100}));
+        REQUIRE(sameEvent(events[3], {0, 0xF8, 0, 0}));
+        REQUIRE(sameEvent(events[4], {0, 0x90, 62, 80}));  // Running status survives
+    }
+
+    SECTION("SysEx is skipped and cancels running status") {
+        auto events = parseAll(parser, {0x90, 60, 100, 0xF0, 0x41, 0x10, 0xF8, 0x20, 0xF7, 62, 80, 0x80, 60, 0});
+        REQUIRE(events.size() == 3);
+        REQUIRE(sameEvent(events[0], {0, 0x90, 60, 100}));
+        REQUIRE(sameEvent(events[1], {0, 0xF8, 0, 0}));   // Realtime inside SysEx
+        REQUIRE(sameEvent(events[2], {0, 0x80, 60, 0}));  // 62, 80 had no status
+    }
+
+    SECTION("A status byte ends an unterminated SysEx") {
+        auto events = parseAll(parser, {0xF0, 0x41, 0x10, 0x90, 60, 100});
+        REQUIRE(events.size() == 1);
+        REQUIRE(sameEvent(events[0], {0, 0x90, 60, 100}));
+    }
+
+    SECTION("System common messages cancel running status") {
+        auto events = parseAll(parser, {0x90, 60, 100, 0xF2, 0x10, 0x20, 62, 80, 0xF6, 0xF3, 3});
+        REQUIRE(events.size() == 4);
+        REQUIRE(sameEvent(events[1], {0, 0xF2, 0x10, 0x20}));
+        REQUIRE(sameEvent(events[2], {0, 0xF6, 0, 0}));
+        REQUIRE(sameEvent(events[3], {0, 0xF3, 3, 0}));
+    }
+
+    SECTION("Data bytes before any status are dropped") {
+        auto events = parseAll(parser, {60, 100, 0x90, 60, 100});
+        REQUIRE(events.size() == 1);
+    }
+
+    SECTION("A new status abandons an incomplete message") {
+        auto events = parseAll(parser, {0x90, 60, 0xB0, 1, 64});
+        REQUIRE(events.size() == 1);
+        REQUIRE(sameEvent(events[0], {0, 0xB0, 1, 64}));
+    }
+}
+
+TEST_CASE("MidiParser fuzz", "[midi_parser]") {
+    Random rng(2024);
+    auto randomInt = [&rng](int n) { return static_cast<int>(rng.nextUInt() % static_cast<uint32_t>(n)); };
+
+    SECTION("Random valid streams parse back to the messages that produced them") {
+        // Encoder: random channel/system messages, running status where
+        // allowed, realtime bytes sprinkled anywhere, SysEx in between
+        std::vector<uint8_t> bytes;
+        std::vector<MidiEvent> expected;
+        uint8_t runningStatus = 0;
+
+        auto addRealtime = [&]() {
+            static const uint8_t realtime[] = {0xF8, 0xFA, 0xFB, 0xFC, 0xFE, 0xFF};
+            uint8_t byte = realtime[randomInt(6)];
+            bytes.push_back(byte);
+            expected.push_back({0, byte, 0, 0});
+        };
+
+        for (int m = 0; m < 20000; ++m) {
+            int kind = randomInt(20);
+            if (kind == 0) {
+                // SysEx with a few data bytes (and maybe realtime inside)
+                bytes.push_back(0xF0);
+                int length = randomInt(8);
+                for (int i = 0; i < length; ++i) {
+                    if (randomInt(4) == 0) addRealtime();
+                    bytes.push_back(static_cast<uint8_t>(randomInt(128)));
+                }
+                bytes.push_back(0xF7);
+                runningStatus = 0;
+                continue;
+            }
+
+            uint8_t status;
+            if (kind == 1) {
+                static const uint8_t common[] = {0xF1, 0xF2, 0xF3, 0xF6};
+                status = common[randomInt(4)];
+            } else {
+                status = static_cast<uint8_t>(0x80 + randomInt(0x70));
+            }
+
+            int length = MidiParser::dataLength(status);
+            MidiEvent event = {0, status, 0, 0};
+            if (length > 0) event.data1 = static_cast<uint8_t>(randomInt(128));
+            if (length > 1) event.data2 = static_cast<uint8_t>(randomInt(128));
+
+            if (status != runningStatus || randomInt(2) == 0) {
+                bytes.push_back(status);
+            }
+            runningStatus = status < 0xF0 ? status : 0;
+
+            if (length > 0) {
+                if (randomInt(4) == 0) addRealtime();
+                bytes.push_back(event.data1);
+            }
+            if (length > 1) {
+                if (randomInt(4) == 0) addRealtime();
+                bytes.push_back(event.data2);
+            }
+            expected.push_back(event);
+
+            if (randomInt(8) == 0) addRealtime();
+        }
+
+        // Feed in random-sized chunks (the parser keeps state between them)
+        MidiParser parser;
+        std::vector<MidiEvent> events;
+        MidiEvent event;
+        size_t pos = 0;
+        while (pos < bytes.size()) {
+            size_t chunk = std::min(bytes.size() - pos, static_cast<size_t>(1 + randomInt(256)));
+            for (size_t i = 0; i < chunk; ++i) {
+                if (parser.processByte(bytes[pos + i], 0, event)) {
+                    events.push_back(event);
+                }
+            }
+            pos += chunk;
+        }
+
+        REQUIRE(events.size() == expected.size());
+        bool allMatch = true;
+        for (size_t i = 0; i < events.size(); ++i) {
+            allMatch = allMatch && sameEvent(events[i], expected[i]);
+        }
+        REQUIRE(allMatch);
+    }
+
+    SECTION("Random garbage only yields well-formed events and resyncs") {
+        MidiParser parser;
+        MidiEvent event;
+        bool wellFormed = true;
+        for (int i = 0; i < 200000; ++i) {
+            uint8_t byte = static_cast<uint8_t>(rng.nextUInt());
+            if (parser.processByte(byte, 0, event)) {
+                int length = MidiParser::dataLength(event.status);
+                wellFormed = wellFormed && (event.status & 0x80) &&
+                             event.data1 < 0x80 && event.data2 < 0x80 &&
+                             (length >= 1 || event.data1 == 0) &&
+                             (length >= 2 || event.data2 == 0);
+            }
+        }
+        REQUIRE(wellFormed);
+
+        // Whatever state the garbage left behind, a status byte resyncs
+        auto events = parseAll(parser, {0x90, 60, 100});
+        REQUIRE(events.size() == 1);
+        REQUIRE(sameEvent(events[0], {0, 0x90, 60, 100}));
+    }
+}
+
+TEST_CASE("MidiParser benchmarks", "[.][benchmark][midi_parser]") {
+    // Dense DAW-style stream: chords with running status, CC sweeps, clock
+    std::vector<uint8_t> bytes;
+    while (bytes.size() < 48000) {
+        bytes.insert(bytes.end(), {0x90, 60, 100, 64, 100, 67, 100, 0xF8});
+        bytes.insert(bytes.end(), {0xB0, 74, 10, 74, 11, 74, 12, 71, 40});
+        bytes.insert(bytes.end(), {0xE0, 0x00, 0x40, 0x80, 60, 0, 64, 0, 67, 0});
+    }
+
+    MidiParser parser;
+    BENCHMARK("Parse 48 KB") {
+        MidiEvent event;
+        int count = 0;
+        for (uint8_t byte : bytes) {
+            count += parser.processByte(byte, 0, event) ? 1 : 0;
+        }
+        return count;
+    };
+}
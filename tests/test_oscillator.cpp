@@ -1,9 +1,12 @@
 /**
  * Unit tests for Oscillator and DCO components
+ *
+ * Benchmarks are hidden; run them with: phj_tests "[benchmark]"
  */
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <cmath>
 #include <vector>
 #include "oscillator.h"
@@ -292,3 +295,118 @@ TEST_CASE("DCO Range (M14)", "[dco][m14]") {
         REQUIRE(samples16 != samples4);
     }
 }
+
+TEST_CASE("DCO pitch drift", "[dco]") {
+    Dco dco;
+    dco.setSampleRate(48000.0f);
+    dco.setFrequency(440.0f);
+    dco.setSeed(11);
+
+    DcoParams params;
+    params.sawLevel = 1.0f;
+    params.enableDrift = true;
+    dco.setParameters(params);
+    dco.noteOn();
+
+    // Rising zero crossings of the saw over one second = frequency in Hz
+    auto measureFrequency = [&dco]() {
+        int crossings = 0;
+        Sample previous = dco.process();
+        for (int i = 1; i < 48000; ++i) {
+            Sample current = dco.process();
+            if (previous < 0.0f && current >= 0.0f) {
+                ++crossings;
+            }
+            previous = current;
+        }
+        return crossings;
+    };
+
+    SECTION("Drift stays within a few cents of the played pitch") {
+        // Drift is bounded to about ±2 cents (< 0.6 Hz at 440 Hz)
+        for (int second = 0; second < 5; ++second) {
+            REQUIRE(std::abs(measureFrequency() - 440) <= 1);
+        }
+    }
+
+    SECTION("Disabling drift restores the exact pitch") {
+        measureFrequency();
+        params.enableDrift = false;
+        dco.setParameters(params);
+        REQUIRE(measureFrequency() == 440);
+    }
+}
+
+TEST_CASE("DCO drift keeps its control rate under frequency updates", "[dco]") {
+    // Portamento sets the frequency every sample; the drift must still tick
+    // once per control interval, so re-setting the same frequency changes nothing
+    DcoParams params;
+    params.sawLevel = 1.0f;
+    params.enableDrift = true;
+
+    Dco updated, reference;
+    for (Dco* dco : {&updated, &reference}) {
+        dco->setSampleRate(48000.0f);
+        dco->setFrequency(440.0f);
+        dco->setSeed(11);
+        dco->setParameters(params);
+        dco->noteOn();
+    }
+
+    int mismatches = 0;
+    for (int i = 0; i < 48000; ++i) {
+        updated.setFrequency(440.0f);
+        mismatches += updated.process() != reference.process();
+    }
+    REQUIRE(mismatches == 0);
+
+    SECTION("A new frequency rescales the drift ramp in place") {
+        // Mid-ramp jump by an exact octave, then re-set every sample
+        for (int i = 0; i < 17; ++i) {
+            updated.process();
+            reference.process();
+        }
+        reference.setFrequency(880.0f);
+        for (int i = 0; i < 48000; ++i) {
+            updated.setFrequency(880.0f);
+            mismatches += updated.process() != reference.process();
+        }
+        REQUIRE(mismatches == 0);
+    }
+}
+
+TEST_CASE("DCO benchmarks", "[.][benchmark][dco]") {
+    Dco dco;
+    dco.setSampleRate(48000.0f);
+    dco.setFrequency(220.0f);
+
+    DcoParams params;
+    params.sawLevel = 1.0f;
+
+    std::vector<Sample> output(512);
+
+    BENCHMARK("Saw with drift x512") {
+        params.enableDrift = true;
+        dco.setParameters(params);
+        dco.process(output.data(), 512);
+        return output[511];
+    };
+
+    BENCHMARK("Saw without drift x512") {
+        params.enableDrift = false;
+        dco.setParameters(params);
+        dco.process(output.data(), 512);
+        return output[511];
+    };
+
+    BENCHMARK("Saw with drift and LFO pitch x512") {
+        params.enableDrift = true;
+        params.lfoTarget = DcoParams::LFO_PITCH;
+        dco.setParameters(params);
+        for (int i = 0; i < 512; ++i) {
+            dco.setLfoValue(0.001f * i);
+            output[i] = dco.process();
+        }
+        return output[511];
+    };
+}
@@ -0,0 +1,134 @@
+/**
+ * Unit tests and benchmarks for the parameter registry and CC map
+ *
+ * Benchmarks are hidden; run them with: phj_tests "[benchmark]"
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cmath>
+#include <string>
+#include "param_registry.h"
+#include "synth.h"
+
+using namespace phj;
+using Catch::Matchers::WithinAbs;
+using Catch::Matchers::WithinRel;
+
+TEST_CASE("Parameter descriptors are consistent", "[params]") {
+    for (int i = 0; i < static_cast<int>(ParamId::PARAM_COUNT); ++i) {
+        const ParamDescriptor& desc = paramDescriptor(static_cast<ParamId>(i));
+        INFO(desc.name);
+        REQUIRE(desc.min < desc.max);
+        if (desc.curve == ParamCurve::Exponential) {
+            REQUIRE(desc.min > 0.0f);
+            REQUIRE_THAT(desc.log2Ratio, WithinRel(std::log2(desc.max / desc.min), 1e-6f));
+        }
+        // Integer fields are stepped and never smoothed
+        if (desc.type != ParamType::Float) {
+            REQUIRE(desc.curve == ParamCurve::Stepped);
+            REQUIRE(desc.smoothingMs == 0.0f);
+        }
+    }
+}
+
+TEST_CASE("Parameter curves", "[params]") {
+    SECTION("Exponential curves match min * (max / min)^x") {
+        const ParamDescriptor& decay = paramDescriptor(ParamId::AMP_ENV_DECAY);
+        for (int value = 0; value < 128; ++value) {
+            float x = value / 127.0f;
+            REQUIRE_THAT(paramValueFromNormalized(decay, x), WithinRel(0.002f * std::pow(6000.0f, x), 1e-5f));
+        }
+        REQUIRE_THAT(paramValueFromNormalized(decay, 1.0f), WithinRel(12.0f, 1e-5f));
+    }
+
+    SECTION("Stepped curves split the control range evenly") {
+        const ParamDescriptor& chorus = paramDescriptor(ParamId::CHORUS_MODE);
+        const ParamDescriptor& vcaMode = paramDescriptor(ParamId::VCA_MODE);
+        for (int value = 0; value < 128; ++value) {
+            float x = value / 127.0f;
+            REQUIRE(paramValueFromNormalized(chorus, x) == static_cast<float>(static_cast<int>(x * 3.99f)));
+            REQUIRE(paramValueFromNormalized(vcaMode, x) == (value >= 64 ? 1.0f : 0.0f));
+        }
+    }
+
+    SECTION("Linear and quadratic curves") {
+        REQUIRE_THAT(paramValueFromNormalized(paramDescriptor(ParamId::MASTER_TUNE), 0.5f), WithinAbs(0.0f, 1e-5f));
+        REQUIRE_THAT(paramValueFromNormalized(paramDescriptor(ParamId::PORTAMENTO_TIME), 0.5f), WithinAbs(2.5f, 1e-5f));
+        REQUIRE(paramValueFromNormalized(paramDescriptor(ParamId::FILTER_ENV_AMOUNT), -3.0f) == -1.0f);  // Clamped
+    }
+}
+
+TEST_CASE("MIDI CC map", "[params]") {
+    REQUIRE(ccToParam(74) == ParamId::FILTER_CUTOFF);
+    REQUIRE(ccToParam(71) == ParamId::FILTER_RESONANCE);
+    REQUIRE(ccToParam(91) == ParamId::CHORUS_MODE);
+    REQUIRE(ccToParam(64) == ParamId::PARAM_COUNT);   // Sustain is handled by Synth
+    REQUIRE(ccToParam(127) == ParamId::PARAM_COUNT);  // Unassigned
+    REQUIRE(ccToParam(-1) == ParamId::PARAM_COUNT);
+    REQUIRE(ccToParam(128) == ParamId::PARAM_COUNT);
+}
+
+TEST_CASE("Synth parameter access through the registry", "[params][synth]") {
+    Synth synth;
+
+    SECTION("CCs write the mapped field") {
+        synth.handleControlChange(74, 127);
+        REQUIRE(synth.getParamValue(ParamId::FILTER_CUTOFF) == 1.0f);
+        synth.handleControlChange(79, 0);
+        REQUIRE_THAT(synth.getParamValue(ParamId::FILTER_ENV_ATTACK), WithinRel(0.001f, 1e-5f));
+        synth.handleControlChange(19, 127);
+        REQUIRE(synth.getParamValue(ParamId::DCO_RANGE) == 2.0f);
+        synth.handleControlChange(23, 64);
+        REQUIRE(synth.getParamValue(ParamId::VCA_MODE) == 1.0f);
+    }
+
+    SECTION("Plain values are clamped to the range") {
+        synth.setParamValue(ParamId::LFO_RATE, 100.0f);
+        REQUIRE(synth.getParamValue(ParamId::LFO_RATE) == 30.0f);
+        synth.setParamValue(ParamId::DCO_DRIFT, 0.0f);
+        REQUIRE(synth.getParamValue(ParamId::DCO_DRIFT) == 0.0f);
+        synth.setParamValue(ParamId::FILTER_HPF_MODE, 2.0f);
+        REQUIRE(synth.getParamValue(ParamId::FILTER_HPF_MODE) == 2.0f);
+    }
+
+    SECTION("Invalid ids are ignored") {
+        synth.setParam(ParamId::PARAM_COUNT, 1.0f);
+        synth.setParamValue(static_cast<ParamId>(1000), 1.0f);
+        REQUIRE(synth.getParamValue(ParamId::PARAM_COUNT) == 0.0f);
+    }
+
+    SECTION("Registry writes match the struct setters") {
+        // The same change through setParam and setFilterParameters renders
+        // identically (with the registry's ramp turned off)
+        Synth other;
+        synth.setParamSmoothing(ParamId::FILTER_CUTOFF, 0.0f);
+        FilterParams filterParams;
+        filterParams.cutoff = 0.25f;
+        other.setFilterParameters(filterParams);
+        synth.setParamValue(ParamId::FILTER_CUTOFF, 0.25f);
+        for (Synth* s : {&synth, &other}) {
+            s->setSeed(3);
+            s->handleNoteOn(57, 1.0f);
+        }
+        std::vector<Sample> a(1024), b(1024), right(1024);
+        synth.processStereo(a.data(), right.data(), 1024);
+        other.processStereo(b.data(), right.data(), 1024);
+        REQUIRE(a == b);
+    }
+}
+
+TEST_CASE("Parameter registry benchmarks", "[.][benchmark][params]") {
+    Synth synth;
+    int value = 0;
+
+    BENCHMARK("CC dispatch (cutoff)") {
+        synth.handleControlChange(74, value++ & 127);
+        return value;
+    };
+    BENCHMARK("CC dispatch (exponential: amp decay)") {
+        synth.handleControlChange(84, value++ & 127);
+        return value;
+    };
+}
@@ -0,0 +1,234 @@
+/**
+ * Unit tests and benchmarks for parameter smoothing
+ *
+ * Benchmarks are hidden; run them with: phj_tests "[benchmark]"
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "param_smoother.h"
+#include "synth.h"
+
+using namespace phj;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+struct Written {
+    ParamId id = ParamId::PARAM_COUNT;
+    float value = 0.0f;
+    int count = 0;
+};
+
+// Advance and record the last value written for each parameter
+void advance(ParamSmoother& smoother, int numSamples, Written* written) {
+    smoother.advance(numSamples, [written](ParamId id, float value) {
+        Written& w = written[static_cast<int>(id)];
+        w.id = id;
+        w.value = value;
+        ++w.count;
+    });
+}
+
+} // namespace
+
+TEST_CASE("ParamSmoother ramps", "[smoother]") {
+    ParamSmoother smoother;
+    smoother.setSampleRate(48000.0f);
+    Written written[static_cast<int>(ParamId::PARAM_COUNT)];
+    const int cutoff = static_cast<int>(ParamId::FILTER_CUTOFF);
+
+    SECTION("Times default to the descriptors") {
+        REQUIRE(smoother.getTime(ParamId::FILTER_CUTOFF) == paramDescriptor(ParamId::FILTER_CUTOFF).smoothingMs);
+        REQUIRE(smoother.getTime(ParamId::FILTER_ENV_ATTACK) == 0.0f);
+        smoother.setTime(ParamId::CHORUS_MODE, 10.0f);  // Stepped: ignored
+        REQUIRE(smoother.getTime(ParamId::CHORUS_MODE) == 0.0f);
+    }
+
+    SECTION("Linear ramp ends exactly on the target") {
+        smoother.setTime(ParamId::FILTER_CUTOFF, 10.0f);  // 480 samples
+        REQUIRE(smoother.start(ParamId::FILTER_CUTOFF, 0.0f, 0.96f));
+        REQUIRE(smoother.isActive(ParamId::FILTER_CUTOFF));
+
+        advance(smoother, 32, written);
+        REQUIRE_THAT(written[cutoff].value, WithinAbs(0.064f, 1e-6f));
+        for (int i = 0; i < 13; ++i) {
+            advance(smoother, 32, written);
+        }
+        REQUIRE_THAT(written[cutoff].value, WithinAbs(0.896f, 1e-5f));
+        REQUIRE(smoother.isActive());
+
+        advance(smoother, 32, written);  // Sample 480
+        REQUIRE(written[cutoff].value == 0.96f);
+        REQUIRE(written[cutoff].count == 15);
+        REQUIRE_FALSE(smoother.isActive());
+
+        advance(smoother, 32, written);  // At rest: nothing written
+        REQUIRE(written[cutoff].count == 15);
+    }
+
+    SECTION("A new target restarts the ramp from the current value") {
+        REQUIRE(smoother.start(ParamId::FILTER_CUTOFF, 0.0f, 1.0f));
+        advance(smoother, 240, written);
+        REQUIRE(smoother.start(ParamId::FILTER_CUTOFF, written[cutoff].value, 0.0f));
+        advance(smoother, 479, written);
+        REQUIRE(written[cutoff].value > 0.0f);
+        advance(smoother, 1, written);
+        REQUIRE(written[cutoff].value == 0.0f);
+        REQUIRE_FALSE(smoother.isActive());
+    }
+
+    SECTION("Unsmoothed parameters are left to the caller") {
+        REQUIRE_FALSE(smoother.start(ParamId::FILTER_ENV_ATTACK, 0.1f, 1.0f));
+        smoother.setTime(ParamId::FILTER_CUTOFF, 0.0f);
+        REQUIRE_FALSE(smoother.start(ParamId::FILTER_CUTOFF, 0.0f, 1.0f));
+        REQUIRE_FALSE(smoother.isActive());
+    }
+
+    SECTION("Only moving parameters are evaluated") {
+        REQUIRE(smoother.start(ParamId::FILTER_CUTOFF, 0.0f, 1.0f));
+        REQUIRE(smoother.start(ParamId::DCO_SAW_LEVEL, 0.0f, 1.0f));  // 5 ms
+        advance(smoother, 240, written);
+        REQUIRE_FALSE(smoother.isActive(ParamId::DCO_SAW_LEVEL));
+        advance(smoother, 32, written);
+        REQUIRE(written[static_cast<int>(ParamId::DCO_SAW_LEVEL)].count == 1);
+        REQUIRE(written[cutoff].count == 2);
+        REQUIRE(written[static_cast<int>(ParamId::FILTER_RESONANCE)].count == 0);
+    }
+
+    SECTION("Aliased fields keep one ramp") {
+        REQUIRE(smoother.start(ParamId::VCA_LEVEL, 1.0f, 0.0f));
+        REQUIRE(smoother.start(ParamId::MASTER_VOLUME, 1.0f, 0.5f));
+        REQUIRE_FALSE(smoother.isActive(ParamId::VCA_LEVEL));
+        REQUIRE(smoother.isActive(ParamId::MASTER_VOLUME));
+    }
+
+    SECTION("Stopping a parameter struct") {
+        REQUIRE(smoother.start(ParamId::FILTER_CUTOFF, 0.0f, 1.0f));
+        REQUIRE(smoother.start(ParamId::FILTER_RESONANCE, 0.0f, 1.0f));
+        REQUIRE(smoother.start(ParamId::DCO_PULSE_WIDTH, 0.5f, 0.9f));
+        smoother.stop(ParamTarget::Filter);
+        REQUIRE_FALSE(smoother.isActive(ParamId::FILTER_CUTOFF));
+        REQUIRE_FALSE(smoother.isActive(ParamId::FILTER_RESONANCE));
+        REQUIRE(smoother.isActive(ParamId::DCO_PULSE_WIDTH));
+    }
+}
+
+TEST_CASE("Synth smooths registry writes", "[smoother][synth]") {
+    DcoParams dcoParams;
+    dcoParams.sawLevel = 1.0f;
+    dcoParams.enableDrift = false;
+    EnvelopeParams ampEnv;
+    ampEnv.attack = 0.001f;
+    ampEnv.sustain = 1.0f;
+
+    auto setUp = [&](Synth& synth) {
+        synth.setSampleRate(48000.0f);
+        synth.setDcoParameters(dcoParams);
+        synth.setAmpEnvParameters(ampEnv);
+        synth.setSeed(9);
+        synth.handleNoteOn(57, 1.0f);
+    };
+
+    auto render = [](Synth& synth, int numSamples) {
+        std::vector<Sample> left(numSamples);
+        std::vector<Sample> right(numSamples);
+        synth.processStereo(left.data(), right.data(), numSamples);
+        return left;
+    };
+
+    auto peak = [](const std::vector<Sample>& block, int begin, int end) {
+        float result = 0.0f;
+        for (int i = begin; i < end; ++i) {
+            result = std::max(result, std::abs(block[i]));
+        }
+        return result;
+    };
+
+    SECTION("A level step becomes a ramp") {
+        Synth smoothed, stepped, reference;
+        setUp(smoothed);
+        setUp(stepped);
+        setUp(reference);
+        stepped.setParamSmoothing(ParamId::VCA_LEVEL, 0.0f);
+        render(smoothed, 4800);
+        render(stepped, 4800);
+        render(reference, 4800);
+
+        smoothed.setParamValue(ParamId::VCA_LEVEL, 0.0f);
+        stepped.setParamValue(ParamId::VCA_LEVEL, 0.0f);
+        REQUIRE(smoothed.getParamValue(ParamId::VCA_LEVEL) == 0.0f);  // Target
+
+        // 5 ms = 240 samples: each control block plays at the ramp's level at
+        // its end, then the output stays at zero
+        std::vector<Sample> out = render(smoothed, 480);
+        std::vector<Sample> ref = render(reference, 480);
+        REQUIRE(peak(render(stepped, 32), 0, 32) == 0.0f);
+        for (int block = 0; block < 7; ++block) {
+            INFO("block " << block);
+            const float level = 1.0f - (block + 1) * 32 / 240.0f;
+            const float gain = peak(out, block * 32, block * 32 + 32) / peak(ref, block * 32, block * 32 + 32);
+            REQUIRE_THAT(gain, WithinAbs(level, 1e-3f));
+        }
+        REQUIRE(peak(out, 240, 480) == 0.0f);
+    }
+
+    SECTION("A CC lands on its value when the ramp ends") {
+        Synth synth;
+        setUp(synth);
+        synth.handleControlChange(74, 0);
+        REQUIRE(synth.getParamValue(ParamId::FILTER_CUTOFF) == 0.0f);
+        render(synth, 1024);
+        REQUIRE(synth.getParamValue(ParamId::FILTER_CUTOFF) == 0.0f);
+    }
+
+    SECTION("Struct setters cancel ramps") {
+        Synth synth;
+        setUp(synth);
+        synth.setParamValue(ParamId::FILTER_CUTOFF, 0.2f);
+        FilterParams filterParams;
+        filterParams.cutoff = 0.8f;
+        synth.setFilterParameters(filterParams);
+        render(synth, 1024);
+        REQUIRE(synth.getParamValue(ParamId::FILTER_CUTOFF) == 0.8f);
+    }
+
+    SECTION("Reset lands ramps on their targets") {
+        Synth synth;
+        setUp(synth);
+        synth.setParamValue(ParamId::DCO_PULSE_WIDTH, 0.9f);
+        synth.reset();
+        synth.setParamSmoothing(ParamId::DCO_PULSE_WIDTH, 0.0f);
+        REQUIRE(synth.getParamValue(ParamId::DCO_PULSE_WIDTH) == 0.9f);
+    }
+
+    SECTION("Ramps finish while idle") {
+        Synth synth;
+        synth.setParamValue(ParamId::FILTER_RESONANCE, 1.0f);
+        render(synth, 512);
+        REQUIRE(synth.isIdle());
+        REQUIRE(synth.getParamValue(ParamId::FILTER_RESONANCE) == 1.0f);
+    }
+}
+
+TEST_CASE("Parameter smoothing benchmarks", "[.][benchmark][smoother]") {
+    Synth synth;
+    synth.handleNoteOn(57, 1.0f);
+    std::vector<Sample> left(128), right(128);
+    int value = 0;
+
+    BENCHMARK("128 frames, parameters at rest") {
+        synth.processStereo(left.data(), right.data(), 128);
+        return left[0];
+    };
+    BENCHMARK("128 frames, cutoff + resonance sweep") {
+        synth.handleControlChange(74, value & 127);
+        synth.handleControlChange(71, 127 - (value++ & 127));
+        synth.processStereo(left.data(), right.data(), 128);
+        return left[0];
+    };
+}
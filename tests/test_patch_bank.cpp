@@ -0,0 +1,171 @@
+/**
+ * Unit tests and benchmarks for the binary patch bank format
+ *
+ * Benchmarks are hidden; run them with: phj_tests "[benchmark]"
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include "patch_bank.h"
+
+using namespace phj;
+
+namespace {
+
+Patch makeTestPatch() {
+    Patch patch;
+    patch.dco.sawLevel = 0.25f;
+    patch.dco.pulseLevel = 0.75f;
+    patch.dco.subLevel = 0.5f;
+    patch.dco.noiseLevel = 0.125f;
+    patch.dco.pulseWidth = 0.3f;
+    patch.dco.pwmDepth = 0.6f;
+    patch.dco.lfoTarget = DcoParams::LFO_PWM;
+    patch.dco.range = DcoParams::RANGE_4;
+    patch.dco.detune = -3.0f;
+    patch.dco.enableDrift = false;
+    patch.filter.cutoff = 0.45f;
+    patch.filter.resonance = 0.8f;
+    patch.filter.envAmount = -0.5f;
+    patch.filter.lfoAmount = 0.2f;
+    patch.filter.keyTrack = FilterParams::KEY_TRACK_FULL;
+    patch.filter.drive = 2.0f;
+    patch.filter.hpfMode = 2;
+    patch.filterEnv.attack = 0.02f;
+    patch.filterEnv.decay = 1.5f;
+    patch.filterEnv.sustain = 0.1f;
+    patch.filterEnv.release = 2.0f;
+    patch.ampEnv.attack = 0.5f;
+    patch.ampEnv.decay = 0.7f;
+    patch.ampEnv.sustain = 0.9f;
+    patch.ampEnv.release = 4.0f;
+    patch.lfo.rate = 6.5f;
+    patch.lfo.delay = 1.25f;
+    patch.chorus.mode = 3;
+    patch.performance.pitchBendRange = 7.0f;
+    patch.performance.portamentoTime = 0.4f;
+    patch.performance.vcaMode = PerformanceParams::VCA_GATE;
+    patch.performance.filterEnvPolarity = PerformanceParams::FILTER_ENV_INVERSE;
+    patch.performance.vcaLevel = 0.55f;
+    patch.performance.masterTune = 12.0f;
+    patch.performance.velocityToFilter = 0.35f;
+    patch.performance.velocityToAmp = 0.65f;
+    patch.performance.voiceAllocationMode = PerformanceParams::VOICE_ALLOC_HIGH_NOTE;
+    return patch;
+}
+
+// A bank image in memory: header followed by the records
+std::vector<uint32_t> makeImage(const PatchRecord* records, int count) {
+    std::vector<uint32_t> image((sizeof(BankHeader) + count * sizeof(PatchRecord)) / 4);
+    BankHeader header = makeBankHeader(count);
+    std::memcpy(image.data(), &header, sizeof(header));
+    std::memcpy(reinterpret_cast<char*>(image.data()) + sizeof(header), records, count * sizeof(PatchRecord));
+    return image;
+}
+
+} // namespace
+
+TEST_CASE("Patch records round-trip", "[patch_bank]") {
+    const Patch patch = makeTestPatch();
+    PatchRecord record;
+    encodePatch(patch, "Brass 1", record);
+    REQUIRE(std::strcmp(record.name, "Brass 1") == 0);
+
+    Patch decoded = decodePatch(record);
+    PatchRecord again;
+    encodePatch(decoded, "Brass 1", again);
+    REQUIRE(std::memcmp(&record, &again, sizeof(record)) == 0);
+
+    REQUIRE(decoded.dco.range == DcoParams::RANGE_4);
+    REQUIRE_FALSE(decoded.dco.enableDrift);
+    REQUIRE(decoded.filter.drive == 2.0f);
+    REQUIRE(decoded.ampEnv.release == 4.0f);
+    REQUIRE(decoded.chorus.mode == 3);
+    REQUIRE(decoded.performance.voiceAllocationMode == PerformanceParams::VOICE_ALLOC_HIGH_NOTE);
+
+    SECTION("Names longer than the field are truncated") {
+        encodePatch(patch, "A very long patch name", record);
+        REQUIRE(std::memcmp(record.name, "A very long patc", PATCH_NAME_LENGTH) == 0);
+    }
+}
+
+TEST_CASE("Damaged records decode to a playable patch", "[patch_bank]") {
+    PatchRecord record;
+    encodePatch(makeTestPatch(), "Damaged", record);
+    record.cutoff = std::numeric_limits<float>::quiet_NaN();
+    record.resonance = 7.0f;
+    record.ampEnv[3] = std::numeric_limits<float>::infinity();
+    record.chorusMode = 42;
+    record.range = -5;
+    record.drive = 100.0f;
+
+    Patch patch = decodePatch(record);
+    REQUIRE(patch.filter.cutoff == 0.0f);
+    REQUIRE(patch.filter.resonance == 1.0f);
+    REQUIRE(patch.ampEnv.release == 0.002f);
+    REQUIRE(patch.chorus.mode == 3);
+    REQUIRE(patch.dco.range == 0);
+    REQUIRE(patch.filter.drive == 4.0f);
+}
+
+TEST_CASE("Bank images are validated", "[patch_bank]") {
+    PatchRecord records[3];
+    for (int i = 0; i < 3; ++i) {
+        Patch patch;
+        patch.filter.cutoff = 0.1f * (i + 1);
+        encodePatch(patch, "Test", records[i]);
+    }
+    std::vector<uint32_t> image = makeImage(records, 3);
+    const size_t size = image.size() * 4;
+    int count = 0;
+    size_t recordSize = 0;
+
+    SECTION("Records are read in place") {
+        const PatchRecord* found = findBankRecords(image.data(), size, count, recordSize);
+        REQUIRE(found == reinterpret_cast<const PatchRecord*>(reinterpret_cast<const char*>(image.data()) + 16));
+        REQUIRE(count == 3);
+        REQUIRE(recordSize == sizeof(PatchRecord));
+        REQUIRE(found[2].cutoff == records[2].cutoff);
+    }
+
+    SECTION("Truncated images are rejected") {
+        REQUIRE(findBankRecords(image.data(), size - 4, count, recordSize) == nullptr);
+        REQUIRE(findBankRecords(image.data(), 8, count, recordSize) == nullptr);
+        REQUIRE(findBankRecords(nullptr, size, count, recordSize) == nullptr);
+    }
+
+    SECTION("Wrong magic or version is rejected") {
+        BankHeader* header = reinterpret_cast<BankHeader*>(image.data());
+        header->version = BANK_VERSION + 1;
+        REQUIRE(findBankRecords(image.data(), size, count, recordSize) == nullptr);
+        header->version = BANK_VERSION;
+        header->magic[0] = 'X';
+        REQUIRE(findBankRecords(image.data(), size, count, recordSize) == nullptr);
+    }
+
+    SECTION("Larger records from a newer writer are accepted") {
+        // Same version, 8 extra bytes per record
+        const size_t stride = sizeof(PatchRecord) + 8;
+        std::vector<uint32_t> wide((16 + 3 * stride) / 4);
+        BankHeader header = makeBankHeader(3);
+        header.recordSize = static_cast<uint16_t>(stride);
+        std::memcpy(wide.data(), &header, sizeof(header));
+        for (int i = 0; i < 3; ++i) {
+            std::memcpy(reinterpret_cast<char*>(wide.data()) + 16 + i * stride, &records[i], sizeof(PatchRecord));
+        }
+        REQUIRE(findBankRecords(wide.data(), wide.size() * 4, count, recordSize) != nullptr);
+        REQUIRE(recordSize == stride);
+    }
+}
+
+TEST_CASE("Patch bank benchmarks", "[.][benchmark][patch_bank]") {
+    PatchRecord record;
+    encodePatch(makeTestPatch(), "Bench", record);
+
+    BENCHMARK("Decode one record") {
+        return decodePatch(record);
+    };
+}
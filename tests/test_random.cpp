@@ -0,0 +1,77 @@
+/**
+ * Unit tests for Random (PCG32 generator used by the DCO)
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include "random.h"
+
+using namespace phj;
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("Random generator", "[random]") {
+    SECTION("Same seed and stream reproduce the same sequence") {
+        Random a(1234, 3);
+        Random b(1234, 3);
+        for (int i = 0; i < 1000; ++i) {
+            REQUIRE(a.nextUInt() == b.nextUInt());
+        }
+    }
+
+    SECTION("Reseeding restarts the sequence") {
+        Random rng(42);
+        uint32_t first = rng.nextUInt();
+        rng.nextUInt();
+        rng.setSeed(42);
+        REQUIRE(rng.nextUInt() == first);
+    }
+
+    SECTION("Different streams give different sequences") {
+        Random a(1234, 0);
+        Random b(1234, 1);
+        int matches = 0;
+        for (int i = 0; i < 1000; ++i) {
+            if (a.nextUInt() == b.nextUInt()) ++matches;
+        }
+        REQUIRE(matches < 5);
+    }
+
+    SECTION("Uniform floats stay in range with the expected moments") {
+        Random rng;
+        const int count = 200000;
+        double sum = 0.0;
+        double sumBipolar = 0.0;
+        double sumSquaresBipolar = 0.0;
+        for (int i = 0; i < count; ++i) {
+            float unit = rng.nextFloat();
+            REQUIRE(unit >= 0.0f);
+            REQUIRE(unit < 1.0f);
+            sum += unit;
+
+            float bipolar = rng.nextBipolar();
+            REQUIRE(bipolar >= -1.0f);
+            REQUIRE(bipolar < 1.0f);
+            sumBipolar += bipolar;
+            sumSquaresBipolar += bipolar * bipolar;
+        }
+        REQUIRE_THAT(sum / count, WithinAbs(0.5, 0.01));
+        REQUIRE_THAT(sumBipolar / count, WithinAbs(0.0, 0.01));
+        REQUIRE_THAT(sumSquaresBipolar / count, WithinAbs(1.0 / 3.0, 0.01));
+    }
+
+    SECTION("Gaussian approximation has zero mean and unit variance") {
+        Random rng(7);
+        const int count = 200000;
+        double sum = 0.0;
+        double sumSquares = 0.0;
+        for (int i = 0; i < count; ++i) {
+            float x = rng.nextGaussian();
+            REQUIRE(std::abs(x) < 3.5f);
+            sum += x;
+            sumSquares += x * x;
+        }
+        REQUIRE_THAT(sum / count, WithinAbs(0.0, 0.02));
+        REQUIRE_THAT(sumSquares / count, WithinAbs(1.0, 0.03));
+    }
+}
@@ -0,0 +1,166 @@
+/**
+ * Unit tests and benchmarks for the polyphase resampler
+ *
+ * Benchmarks are hidden; run them with: phj_tests "[benchmark]"
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "resampler.h"
+
+using namespace phj;
+
+namespace {
+
+constexpr double TWO_PI = 6.28318530717958647692;
+
+// Stereo sine source: left is sin, right is -sin; counts the pull calls
+struct SineSource {
+    double frequency;
+    double sampleRate;
+    long long frame = 0;
+    int calls = 0;
+
+    static void render(float* interleaved, int numFrames, void* userData) {
+        SineSource* source = static_cast<SineSource*>(userData);
+        for (int i = 0; i < numFrames; ++i) {
+            float value = static_cast<float>(std::sin(TWO_PI * source->frequency * (source->frame + i) / source->sampleRate));
+            interleaved[2 * i] = value;
+            interleaved[2 * i + 1] = -value;
+        }
+        source->frame += numFrames;
+        ++source->calls;
+    }
+};
+
+// Run the resampler in the given period sizes (cycled) until total frames
+std::vector<float> run(Resampler& resampler, SineSource& source, int total, std::vector<int> periods) {
+    std::vector<float> out(total * 2);
+    int done = 0;
+    for (size_t i = 0; done < total; ++i) {
+        int frames = std::min(periods[i % periods.size()], total - done);
+        resampler.process(out.data() + done * 2, frames, SineSource::render, &source);
+        done += frames;
+    }
+    return out;
+}
+
+// Largest deviation of the left channel from the ideal sine at the output
+// rate, skipping the start-up transient
+double maxError(const std::vector<float>& out, double frequency, double outRate, int skip) {
+    double error = 0.0;
+    for (size_t n = skip; n < out.size() / 2; ++n) {
+        double ideal = std::sin(TWO_PI * frequency * n / outRate);
+        error = std::max(error, std::abs(out[2 * n] - ideal));
+    }
+    return error;
+}
+
+double rms(const std::vector<float>& out, int skip) {
+    double sum = 0.0;
+    size_t count = 0;
+    for (size_t n = skip; n < out.size() / 2; ++n, ++count) {
+        sum += static_cast<double>(out[2 * n]) * out[2 * n];
+    }
+    return std::sqrt(sum / count);
+}
+
+} // namespace
+
+TEST_CASE("Resampler configuration", "[resampler]") {
+    Resampler resampler;
+
+    SECTION("Common rate pairs are supported") {
+        REQUIRE(resampler.configure(48000, 44100, 128));
+        REQUIRE(resampler.getTaps() == 70);  // Widened for decimation
+        REQUIRE(resampler.configure(44100, 48000, 128));
+        REQUIRE(resampler.getTaps() == 64);
+        REQUIRE(resampler.configure(48000, 96000, 128));
+        REQUIRE(resampler.configure(48000, 32000, 128));
+    }
+
+    SECTION("Ratios needing too many phases are rejected") {
+        REQUIRE_FALSE(resampler.configure(48000, 47999, 128));
+        REQUIRE_FALSE(resampler.configure(0, 48000, 128));
+    }
+
+    SECTION("Equal rates pass the source through") {
+        REQUIRE(resampler.configure(48000, 48000, 128));
+        REQUIRE(resampler.getLatency() == 0);
+        SineSource source{1000.0, 48000.0};
+        std::vector<float> out = run(resampler, source, 256, {128});
+        REQUIRE(maxError(out, 1000.0, 48000.0, 0) < 1e-6);
+    }
+}
+
+TEST_CASE("Resampler converts without drift", "[resampler]") {
+    const unsigned int rates[][2] = {{48000, 44100}, {44100, 48000}, {48000, 96000}, {96000, 44100}};
+    for (const auto& rate : rates) {
+        Resampler resampler;
+        REQUIRE(resampler.configure(rate[0], rate[1], 128));
+        SineSource source{1000.0, static_cast<double>(rate[0])};
+
+        // Output frame n lands exactly on input time n * in / out
+        std::vector<float> out = run(resampler, source, 8192, {128});
+        INFO(rate[0] << " -> " << rate[1] << " Hz");
+        REQUIRE(maxError(out, 1000.0, rate[1], resampler.getTaps()) < 1e-4);
+
+        // Exactly one pull per period, and only the frames actually used
+        REQUIRE(source.calls == 8192 / 128);
+        REQUIRE(std::abs(source.frame - 8192.0 * rate[0] / rate[1]) <= resampler.getTaps());
+    }
+}
+
+TEST_CASE("Resampler output does not depend on the period size", "[resampler]") {
+    Resampler a, b;
+    REQUIRE(a.configure(48000, 44100, 128));
+    REQUIRE(b.configure(48000, 44100, 64));
+    SineSource sourceA{440.0, 48000.0};
+    SineSource sourceB{440.0, 48000.0};
+    std::vector<float> outA = run(a, sourceA, 4000, {128});
+    std::vector<float> outB = run(b, sourceB, 4000, {1, 37, 200, 64, 5});
+    REQUIRE(std::memcmp(outA.data(), outB.data(), outA.size() * sizeof(float)) == 0);
+}
+
+TEST_CASE("Resampler filter response", "[resampler]") {
+    Resampler resampler;
+    REQUIRE(resampler.configure(48000, 44100, 128));
+
+    SECTION("Passband is flat") {
+        SineSource source{10000.0, 48000.0};
+        std::vector<float> out = run(resampler, source, 16384, {128});
+        REQUIRE(std::abs(rms(out, resampler.getTaps()) * std::sqrt(2.0) - 1.0) < 1e-3);
+    }
+
+    SECTION("Input above the output Nyquist is rejected") {
+        // 23.5 kHz would alias to 20.6 kHz at 44.1 kHz
+        SineSource source{23500.0, 48000.0};
+        std::vector<float> out = run(resampler, source, 16384, {128});
+        REQUIRE(rms(out, resampler.getTaps()) < 3e-4);  // Below -70 dB
+    }
+
+    SECTION("Stereo channels are independent") {
+        SineSource source{1000.0, 48000.0};
+        std::vector<float> out = run(resampler, source, 1024, {128});
+        bool mirrored = true;
+        for (size_t n = 0; n < out.size(); n += 2) {
+            mirrored = mirrored && out[n] == -out[n + 1];
+        }
+        REQUIRE(mirrored);
+    }
+}
+
+TEST_CASE("Resampler benchmarks", "[.][benchmark][resampler]") {
+    Resampler resampler;
+    resampler.configure(48000, 44100, 128);
+    SineSource source{1000.0, 48000.0};
+    std::vector<float> out(256);
+
+    BENCHMARK("48 kHz -> 44.1 kHz, 128 frames") {
+        resampler.process(out.data(), 128, SineSource::render, &source);
+        return out[0];
+    };
+}
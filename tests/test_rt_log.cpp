@@ -0,0 +1,123 @@
+/**
+ * Unit tests for RtLog (real-time safe log channels)
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+#include "rt_log.h"
+
+using namespace phj;
+
+namespace {
+
+struct Line {
+    LogLevel level;
+    std::string channel;
+    std::string message;
+};
+
+std::vector<Line> g_lines;
+
+void captureSink(LogLevel level, const char* channel, const char* message) {
+    g_lines.push_back({level, channel, message});
+}
+
+// Route drained messages into g_lines for the duration of a test
+struct CaptureScope {
+    LogLevel savedLevel;
+
+    CaptureScope() : savedLevel(RtLog::getLevel()) {
+        RtLog::flush();
+        g_lines.clear();
+        RtLog::setSink(captureSink);
+    }
+
+    ~CaptureScope() {
+        RtLog::flush();
+        RtLog::setSink(nullptr);
+        RtLog::setLevel(savedLevel);
+    }
+};
+
+} // namespace
+
+TEST_CASE("RtLog channels", "[rt_log]") {
+    CaptureScope capture;
+    RtLog log("test");
+
+    SECTION("Messages are formatted and delivered on flush, in order") {
+        RtLog::setLevel(LogLevel::Info);
+        log.log(LogLevel::Info, "Note ON: %d, vel=%d", 60, 100);
+        log.log(LogLevel::Error, "poll failed: %s", "EINTR");
+        REQUIRE(g_lines.empty());  // Nothing is written on the producer side
+
+        RtLog::flush();
+        REQUIRE(g_lines.size() == 2);
+        REQUIRE(g_lines[0].channel == "test");
+        REQUIRE(g_lines[0].message == "Note ON: 60, vel=100");
+        REQUIRE(g_lines[1].level == LogLevel::Error);
+        REQUIRE(g_lines[1].message == "poll failed: EINTR");
+    }
+
+    SECTION("Messages above the current level are filtered") {
+        RtLog::setLevel(LogLevel::Warning);
+        log.log(LogLevel::Debug, "debug");
+        log.log(LogLevel::Info, "info");
+        log.log(LogLevel::Warning, "warning");
+        RtLog::flush();
+        REQUIRE(g_lines.size() == 1);
+        REQUIRE(g_lines[0].message == "warning");
+    }
+
+    SECTION("Long messages are truncated") {
+        RtLog::setLevel(LogLevel::Info);
+        std::string longText(RtLog::MESSAGE_SIZE * 2, 'x');
+        log.log(LogLevel::Info, "%s", longText.c_str());
+        RtLog::flush();
+        REQUIRE(g_lines.size() == 1);
+        REQUIRE(g_lines[0].message.size() == static_cast<size_t>(RtLog::MESSAGE_SIZE - 1));
+    }
+
+    SECTION("A full ring drops messages and reports the count") {
+        RtLog::setLevel(LogLevel::Info);
+        for (int i = 0; i < RtLog::RING_SIZE + 10; ++i) {
+            log.log(LogLevel::Info, "message %d", i);
+        }
+        RtLog::flush();
+        REQUIRE(g_lines.size() == static_cast<size_t>(RtLog::RING_SIZE + 1));
+        REQUIRE(g_lines.back().level == LogLevel::Warning);
+        REQUIRE(g_lines.back().message == "10 log messages dropped (ring full)");
+
+        // Reported once only
+        g_lines.clear();
+        RtLog::flush();
+        REQUIRE(g_lines.empty());
+    }
+}
+
+TEST_CASE("RtLog logger thread", "[rt_log]") {
+    CaptureScope capture;
+    RtLog log("thread");
+    RtLog::setLevel(LogLevel::Info);
+
+    REQUIRE(RtLog::startLogger());
+    for (int i = 0; i < 100; ++i) {
+        log.log(LogLevel::Info, "message %d", i);
+    }
+    RtLog::stopLogger();  // Drains whatever is left
+
+    REQUIRE(g_lines.size() == 100);
+    REQUIRE(g_lines[0].message == "message 0");
+    REQUIRE(g_lines[99].message == "message 99");
+}
+
+TEST_CASE("RtLog level parsing", "[rt_log]") {
+    LogLevel level = LogLevel::Info;
+    REQUIRE(RtLog::parseLevel("debug", level));
+    REQUIRE(level == LogLevel::Debug);
+    REQUIRE(RtLog::parseLevel("error", level));
+    REQUIRE(level == LogLevel::Error);
+    REQUIRE_FALSE(RtLog::parseLevel("verbose", level));
+    REQUIRE(level == LogLevel::Error);
+}
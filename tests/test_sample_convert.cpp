@@ -0,0 +1,178 @@
+/**
+ * Unit tests and benchmarks for the sample conversion kernels
+ *
+ * Benchmarks are hidden; run them with: phj_tests "[benchmark]"
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "sample_convert.h"
+#include "random.h"
+
+using namespace phj;
+
+namespace {
+
+// Interleaved test signal: mostly in range, some clipping, plus exact edge values
+std::vector<float> makeSignal(int count, uint64_t seed) {
+    Random rng(seed);
+    std::vector<float> samples(count);
+    for (float& sample : samples) {
+        sample = rng.nextBipolar() * 1.2f;
+    }
+    static const float edges[] = {0.0f, -0.0f, 1.0f, -1.0f, 1.5f, -1.5f, 0.99999994f,
+                                  1.0f / 32767.0f, -1.0f / 32767.0f, 0.5f / 32767.0f};
+    for (int i = 0; i < static_cast<int>(sizeof(edges) / sizeof(edges[0])) && i < count; ++i) {
+        samples[i] = edges[i];
+        samples[count - 1 - i] = edges[i];
+    }
+    return samples;
+}
+
+template <typename T>
+bool sameBits(const std::vector<T>& a, const std::vector<T>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+} // namespace
+
+TEST_CASE("Sample conversion matches the scalar reference", "[sample_convert]") {
+    // Odd sizes exercise the scalar remainder after the 8-sample SIMD steps
+    for (int count : {1, 3, 8, 13, 256, 1018, 1024}) {
+        std::vector<float> in = makeSignal(count, 1000 + count);
+
+        SECTION("S16, " + std::to_string(count) + " samples") {
+            std::vector<int16_t> simd(count), scalar(count);
+            sampleconv::floatToS16(in.data(), simd.data(), count);
+            sampleconv::reference::floatToS16(in.data(), scalar.data(), count);
+            REQUIRE(sameBits(simd, scalar));
+        }
+
+        SECTION("S32, " + std::to_string(count) + " samples") {
+            std::vector<int32_t> simd(count), scalar(count);
+            sampleconv::floatToS32(in.data(), simd.data(), count);
+            sampleconv::reference::floatToS32(in.data(), scalar.data(), count);
+            REQUIRE(sameBits(simd, scalar));
+        }
+
+        SECTION("S16 dithered, " + std::to_string(count) + " samples") {
+            std::vector<int16_t> simd(count), scalar(count);
+            Random simdRng(7), scalarRng(7);
+            sampleconv::floatToS16Dithered(in.data(), simd.data(), count, simdRng);
+            sampleconv::reference::floatToS16Dithered(in.data(), scalar.data(), count, scalarRng);
+            REQUIRE(sameBits(simd, scalar));
+            REQUIRE(simdRng.nextUInt() == scalarRng.nextUInt());  // Same noise consumed
+        }
+    }
+}
+
+TEST_CASE("Sample conversion values", "[sample_convert]") {
+    const float in[] = {0.0f, -0.0f, 1.0f, 0.99999994f, -1.0f, -0.99999994f, 2.0f, 1.0f,
+                        -2.0f, -1.0f, 0.5f, 0.25f, -0.5f, -0.25f, 1.0f / 32767.0f, 0.0f};
+    const int count = 16;
+
+    SECTION("S16 clamps and scales by 32767") {
+        int16_t out[count];
+        sampleconv::floatToS16(in, out, count);
+        REQUIRE(out[0] == 0);
+        REQUIRE(out[2] == 32767);
+        REQUIRE(out[4] == -32767);
+        REQUIRE(out[6] == 32767);   // Clipped
+        REQUIRE(out[8] == -32767);  // Clipped
+        REQUIRE(out[10] == 16383);
+        REQUIRE(out[14] == 1);
+    }
+
+    SECTION("S32 full scale does not wrap") {
+        int32_t out[count];
+        sampleconv::floatToS32(in, out, count);
+        REQUIRE(out[0] == 0);
+        REQUIRE(out[2] == 2147483520);
+        REQUIRE(out[3] == 2147483520);
+        REQUIRE(out[4] == -2147483647 - 1);
+        REQUIRE(out[6] == 2147483520);  // Clipped
+        REQUIRE(out[8] == -2147483647 - 1);
+        REQUIRE(out[10] == 1073741824);
+    }
+}
+
+TEST_CASE("S16 TPDF dither", "[sample_convert]") {
+    const int count = 131072;
+    Random rng(42);
+    std::vector<int16_t> out(count);
+
+    SECTION("Silence dithers to at most one LSB") {
+        std::vector<float> zeros(count, 0.0f);
+        sampleconv::floatToS16Dithered(zeros.data(), out.data(), count, rng);
+        bool withinOneLsb = true;
+        double sum = 0.0;
+        for (int16_t sample : out) {
+            withinOneLsb = withinOneLsb && sample >= -1 && sample <= 1;
+            sum += sample;
+        }
+        REQUIRE(withinOneLsb);
+        REQUIRE(std::abs(sum / out.size()) < 0.01);
+    }
+
+    SECTION("Sub-LSB levels survive on average") {
+        // 0.3 LSB would truncate to 0 without dither
+        std::vector<float> level(count, 0.3f / 32767.0f);
+        sampleconv::floatToS16Dithered(level.data(), out.data(), count, rng);
+        double sum = 0.0;
+        for (int16_t sample : out) {
+            sum += sample;
+        }
+        REQUIRE(std::abs(sum / out.size() - 0.3) < 0.02);
+    }
+
+    SECTION("Full scale stays in range") {
+        std::vector<float> fullScale(count);
+        for (int i = 0; i < count; ++i) {
+            fullScale[i] = (i & 1) ? -1.0f : 1.0f;
+        }
+        sampleconv::floatToS16Dithered(fullScale.data(), out.data(), count, rng);
+        bool inRange = true;
+        for (int i = 0; i < count; i += 2) {
+            inRange = inRange && out[i] >= 32766 && out[i + 1] <= -32766;
+        }
+        REQUIRE(inRange);
+    }
+}
+
+TEST_CASE("Sample conversion benchmarks", "[.][benchmark][sample_convert]") {
+    const int count = 256;  // One 128-frame stereo period
+    std::vector<float> in = makeSignal(count, 3);
+    std::vector<int16_t> out16(count);
+    std::vector<int32_t> out32(count);
+    Random rng(5);
+
+    BENCHMARK("S16, scalar x256") {
+        sampleconv::reference::floatToS16(in.data(), out16.data(), count);
+        return out16[0];
+    };
+    BENCHMARK("S16, SIMD x256") {
+        sampleconv::floatToS16(in.data(), out16.data(), count);
+        return out16[0];
+    };
+    BENCHMARK("S32, scalar x256") {
+        sampleconv::reference::floatToS32(in.data(), out32.data(), count);
+        return out32[0];
+    };
+    BENCHMARK("S32, SIMD x256") {
+        sampleconv::floatToS32(in.data(), out32.data(), count);
+        return out32[0];
+    };
+    BENCHMARK("S16 dithered, scalar x256") {
+        sampleconv::reference::floatToS16Dithered(in.data(), out16.data(), count, rng);
+        return out16[0];
+    };
+    BENCHMARK("S16 dithered, SIMD x256") {
+        sampleconv::floatToS16Dithered(in.data(), out16.data(), count, rng);
+        return out16[0];
+    };
+}
@@ -0,0 +1,642 @@
+/**
+ * Unit tests for Synth (6-voice engine, block rendering)
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <vector>
+#include "synth.h"
+
+using namespace phj;
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("Synth block rendering", "[synth]") {
+    Synth synth;
+    synth.setSampleRate(48000.0f);
+
+    DcoParams dcoParams;
+    dcoParams.sawLevel = 1.0f;
+    dcoParams.enableDrift = false;
+    synth.setDcoParameters(dcoParams);
+
+    SECTION("Synth is silent with no notes") {
+        std::vector<Sample> left(256);
+        std::vector<Sample> right(256);
+        synth.processStereo(left.data(), right.data(), 256);
+
+        for (size_t i = 0; i < left.size(); ++i) {
+            REQUIRE(left[i] == 0.0f);
+            REQUIRE(right[i] == 0.0f);
+        }
+    }
+
+    SECTION("Synth produces sound after note on") {
+        synth.handleNoteOn(60, 1.0f);
+
+        std::vector<Sample> left(1000);
+        std::vector<Sample> right(1000);
+        synth.processStereo(left.data(), right.data(), 1000);
+
+        float peak = 0.0f;
+        for (Sample s : left) {
+            peak = std::max(peak, std::abs(s));
+        }
+        REQUIRE(peak > 0.01f);
+    }
+
+    SECTION("Buffers larger than MAX_BUFFER_SIZE are fully rendered") {
+        synth.handleNoteOn(60, 1.0f);
+
+        const int numSamples = MAX_BUFFER_SIZE * 3 + 17;
+        std::vector<Sample> left(numSamples, 99.0f);
+        std::vector<Sample> right(numSamples, 99.0f);
+        synth.processStereo(left.data(), right.data(), numSamples);
+
+        // Every sample (including the tail of the last partial block) is written
+        float tailPeak = 0.0f;
+        for (int i = 0; i < numSamples; ++i) {
+            REQUIRE(std::abs(left[i]) < 2.0f);
+            REQUIRE(std::abs(right[i]) < 2.0f);
+            if (i >= numSamples - 17) {
+                tailPeak = std::max(tailPeak, std::abs(left[i]));
+            }
+        }
+        REQUIRE(tailPeak > 0.0f);
+    }
+
+    SECTION("Chorus off gives identical left and right channels") {
+        ChorusParams chorusParams;
+        chorusParams.mode = 0;
+        synth.setChorusParameters(chorusParams);
+        synth.handleNoteOn(60, 1.0f);
+        synth.handleNoteOn(64, 1.0f);
+
+        std::vector<Sample> left(512);
+        std::vector<Sample> right(512);
+        synth.processStereo(left.data(), right.data(), 512);
+
+        for (size_t i = 0; i < left.size(); ++i) {
+            REQUIRE(left[i] == right[i]);
+        }
+    }
+
+    SECTION("Mono output is the average of the stereo channels") {
+        ChorusParams chorusParams;
+        chorusParams.mode = 0;
+        synth.setChorusParameters(chorusParams);
+        synth.handleNoteOn(60, 1.0f);
+
+        std::vector<Sample> mono(700);
+        synth.process(mono.data(), 700);
+
+        float peak = 0.0f;
+        for (Sample s : mono) {
+            peak = std::max(peak, std::abs(s));
+        }
+        REQUIRE(peak > 0.01f);
+    }
+}
+
+TEST_CASE("Synth interleaved output", "[synth]") {
+    auto setUp = [](Synth& synth) {
+        synth.setSampleRate(48000.0f);
+        ChorusParams chorusParams;
+        chorusParams.mode = 2;  // Distinct left and right channels
+        synth.setChorusParameters(chorusParams);
+        synth.handleNoteOn(60, 1.0f);
+        synth.handleNoteOn(64, 0.7f);
+    };
+
+    SECTION("Matches the planar render sample for sample") {
+        Synth planar;
+        Synth interleaved;
+        setUp(planar);
+        setUp(interleaved);
+
+        // Several internal blocks plus a partial one
+        const int numFrames = MAX_BUFFER_SIZE * 2 + 77;
+        std::vector<Sample> left(numFrames), right(numFrames);
+        std::vector<Sample> lr(numFrames * 2, 99.0f);
+        planar.processStereo(left.data(), right.data(), numFrames);
+        interleaved.processInterleaved(lr.data(), numFrames);
+
+        bool same = true;
+        bool stereo = false;
+        for (int i = 0; i < numFrames; ++i) {
+            same = same && lr[i * 2] == left[i] && lr[i * 2 + 1] == right[i];
+            stereo = stereo || left[i] != right[i];
+        }
+        REQUIRE(same);
+        REQUIRE(stereo);
+    }
+
+    SECTION("Queued events are applied") {
+        Synth synth;
+        synth.setSampleRate(48000.0f);
+        synth.postEvent({0, 0x90, 60, 100});
+
+        std::vector<Sample> lr(256 * 2);
+        synth.processInterleaved(lr.data(), 256);
+
+        float peak = 0.0f;
+        for (Sample s : lr) {
+            peak = std::max(peak, std::abs(s));
+        }
+        REQUIRE(peak > 0.01f);
+    }
+}
+
+TEST_CASE("Synth renders are reproducible with a fixed seed", "[synth]") {
+    // Drift, noise and note-on phase all draw from the voices' generators
+    DcoParams dcoParams;
+    dcoParams.sawLevel = 0.8f;
+    dcoParams.noiseLevel = 0.3f;
+    dcoParams.enableDrift = true;
+
+    auto render = [&dcoParams](uint64_t seed) {
+        Synth synth;
+        synth.setSampleRate(48000.0f);
+        synth.setDcoParameters(dcoParams);
+        synth.setSeed(seed);
+        synth.handleNoteOn(60, 1.0f);
+        synth.handleNoteOn(67, 0.8f);
+
+        std::vector<Sample> left(6000);
+        std::vector<Sample> right(6000);
+        synth.processStereo(left.data(), right.data(), 6000);
+        return left;
+    };
+
+    std::vector<Sample> first = render(99);
+    std::vector<Sample> second = render(99);
+    std::vector<Sample> other = render(100);
+
+    REQUIRE(first == second);
+    REQUIRE(first != other);
+}
+
+TEST_CASE("Synth pitch follows the sample rate", "[synth]") {
+    // The engine is configured from the device's negotiated rate: A4 must
+    // stay at 440 Hz at 44.1 kHz as well as 48 kHz
+    for (float sampleRate : {44100.0f, 48000.0f, 96000.0f}) {
+        Synth synth;
+        synth.setSampleRate(sampleRate);
+        DcoParams dcoParams;
+        dcoParams.sawLevel = 1.0f;
+        dcoParams.enableDrift = false;
+        synth.setDcoParameters(dcoParams);
+        synth.handleNoteOn(69, 1.0f);
+
+        // Skip the attack, then count rising zero crossings over one second
+        const int numSamples = static_cast<int>(sampleRate);
+        std::vector<Sample> left(numSamples);
+        std::vector<Sample> right(numSamples);
+        synth.processStereo(left.data(), right.data(), numSamples / 10);
+        synth.processStereo(left.data(), right.data(), numSamples);
+
+        int crossings = 0;
+        for (int i = 1; i < numSamples; ++i) {
+            if (left[i - 1] < 0.0f && left[i] >= 0.0f) {
+                ++crossings;
+            }
+        }
+        INFO("Sample rate " << sampleRate);
+        REQUIRE(std::abs(crossings - 440) <= 2);
+    }
+}
+
+TEST_CASE("Synth deferred parameter updates", "[synth]") {
+    DcoParams dcoParams;
+    dcoParams.sawLevel = 1.0f;
+    dcoParams.enableDrift = false;
+
+    auto setUp = [&dcoParams](Synth& synth) {
+        synth.setSampleRate(48000.0f);
+        synth.setDcoParameters(dcoParams);
+        synth.setSeed(5);
+    };
+
+    auto render = [](Synth& synth, int numSamples) {
+        std::vector<Sample> left(numSamples);
+        std::vector<Sample> right(numSamples);
+        synth.processStereo(left.data(), right.data(), numSamples);
+        return left;
+    };
+
+    SECTION("Idle voices pick up changes at note-on") {
+        // Both synths play and release a note, then go idle; the cutoff
+        // changes while idle (a) or before anything is played (b)
+        Synth a, b;
+        setUp(a);
+        setUp(b);
+        FilterParams dark;
+        dark.cutoff = 0.2f;
+        b.setFilterParameters(dark);
+        EnvelopeParams fast;
+        fast.release = 0.01f;
+        a.setAmpEnvParameters(fast);
+        b.setAmpEnvParameters(fast);
+
+        for (Synth* synth : {&a, &b}) {
+            synth->handleNoteOn(60, 1.0f);
+            render(*synth, 2048);
+            synth->handleNoteOff(60);
+        }
+        render(a, 48000);
+        a.setFilterParameters(dark);
+        render(a, 4096);  // Idle blocks leave the voice untouched
+        render(b, 52096);
+        REQUIRE(a.isIdle());
+        REQUIRE(b.isIdle());
+
+        a.handleNoteOn(60, 1.0f);
+        b.handleNoteOn(60, 1.0f);
+        REQUIRE(render(a, 2048) == render(b, 2048));
+    }
+
+    SECTION("Several changes in one block apply once, last value wins") {
+        Synth a, b;
+        setUp(a);
+        setUp(b);
+        a.handleNoteOn(60, 1.0f);
+        b.handleNoteOn(60, 1.0f);
+        render(a, 256);
+        render(b, 256);
+
+        for (int value = 0; value < 128; ++value) {
+            a.handleControlChange(74, value);  // Cutoff sweep
+            a.handleControlChange(71, 127 - value);  // Resonance
+        }
+        b.handleControlChange(74, 127);
+        b.handleControlChange(71, 0);
+        REQUIRE(render(a, 1024) == render(b, 1024));
+    }
+}
+
+TEST_CASE("Synth idle detection", "[synth]") {
+    Synth synth;
+    synth.setSampleRate(48000.0f);
+
+    EnvelopeParams envParams;
+    envParams.attack = 0.001f;
+    envParams.decay = 0.05f;
+    envParams.sustain = 0.8f;
+    envParams.release = 0.02f;
+    synth.setFilterEnvParameters(envParams);
+    synth.setAmpEnvParameters(envParams);
+
+    ChorusParams chorusParams;
+    chorusParams.mode = Chorus::MODE_BOTH;
+    synth.setChorusParameters(chorusParams);
+
+    std::vector<Sample> left(512);
+    std::vector<Sample> right(512);
+
+    SECTION("A fresh engine is idle and renders silence") {
+        REQUIRE(synth.isIdle());
+        synth.processStereo(left.data(), right.data(), 512);
+        for (size_t i = 0; i < left.size(); ++i) {
+            REQUIRE(left[i] == 0.0f);
+            REQUIRE(right[i] == 0.0f);
+        }
+    }
+
+    SECTION("Note-on leaves idle immediately") {
+        synth.handleNoteOn(60, 1.0f);
+        REQUIRE_FALSE(synth.isIdle());
+
+        synth.processStereo(left.data(), right.data(), 512);
+        float peak = 0.0f;
+        for (Sample s : left) {
+            peak = std::max(peak, std::abs(s));
+        }
+        REQUIRE(peak > 0.01f);
+    }
+
+    SECTION("Engine returns to idle after release and chorus tail") {
+        synth.handleNoteOn(60, 1.0f);
+        synth.processStereo(left.data(), right.data(), 512);
+        synth.handleNoteOff(60);
+
+        // Release plus the chorus delay line: well under 40 blocks
+        int blocks = 0;
+        while (!synth.isIdle() && blocks < 40) {
+            synth.processStereo(left.data(), right.data(), 512);
+            ++blocks;
+        }
+        REQUIRE(synth.isIdle());
+
+        // The last rendered blocks have decayed to silence
+        for (size_t i = 0; i < left.size(); ++i) {
+            REQUIRE(left[i] == 0.0f);
+            REQUIRE(right[i] == 0.0f);
+        }
+    }
+    SECTION("Ramps finish before the engine reports idle") {
+        // Driver-style loop: a period is only rendered while not idle
+        auto runPeriods = [&](int periods) {
+            int rendered = 0;
+            for (int p = 0; p < periods; ++p) {
+                if (!synth.isIdle()) {
+                    synth.processStereo(left.data(), right.data(), 128);
+                    ++rendered;
+                }
+            }
+            return rendered;
+        };
+
+        // Volume to zero while silent: the ramp must run to its end
+        REQUIRE(synth.postEvent({0, MIDI_CONTROL_CHANGE, 7, 0}));
+        const int rendered = runPeriods(400);
+        REQUIRE(rendered > 1);
+        REQUIRE(rendered < 400);
+        REQUIRE(synth.isIdle());
+
+        synth.handleNoteOn(60, 1.0f);
+        runPeriods(4);
+        float peak = 0.0f;
+        for (Sample s : left) {
+            peak = std::max(peak, std::abs(s));
+        }
+        REQUIRE(peak == 0.0f);
+    }
+}
+
+TEST_CASE("Synth queued MIDI events", "[synth]") {
+    std::vector<Sample> left(256), right(256);
+    std::vector<Sample> refLeft(256), refRight(256);
+
+    SECTION("Posted events render the same as direct calls") {
+        Synth direct;
+        Synth queued;
+
+        direct.handleNoteOn(60, 100 / 127.0f);
+        direct.handlePitchBend((12288 - 8192) / 8192.0f);
+        direct.handleControlChange(74, 40);
+
+        REQUIRE(queued.postEvent({0, MIDI_NOTE_ON, 60, 100}));
+        REQUIRE(queued.postEvent({0, MIDI_PITCH_BEND, 0x00, 0x60}));  // 12288
+        REQUIRE(queued.postEvent({0, MIDI_CONTROL_CHANGE, 74, 40}));
+
+        // Pending events keep the engine awake until they are applied
+        REQUIRE_FALSE(queued.isIdle());
+
+        for (int block = 0; block < 4; ++block) {
+            direct.processStereo(refLeft.data(), refRight.data(), 256);
+            queued.processStereo(left.data(), right.data(), 256);
+            REQUIRE(left == refLeft);
+            REQUIRE(right == refRight);
+        }
+    }
+
+    SECTION("Note on with velocity 0 releases the note") {
+        Synth direct;
+        Synth queued;
+        direct.handleNoteOn(64, 1.0f);
+        queued.handleNoteOn(64, 1.0f);
+        direct.processStereo(refLeft.data(), refRight.data(), 256);
+        queued.processStereo(left.data(), right.data(), 256);
+
+        direct.handleNoteOff(64);
+        REQUIRE(queued.postEvent({0, MIDI_NOTE_ON | 0x03, 64, 0}));  // Any channel
+
+        for (int block = 0; block < 4; ++block) {
+            direct.processStereo(refLeft.data(), refRight.data(), 256);
+            queued.processStereo(left.data(), right.data(), 256);
+            REQUIRE(left == refLeft);
+        }
+    }
+
+    SECTION("A full queue rejects further events") {
+        Synth synth;
+        int accepted = 0;
+        while (synth.postEvent({0, MIDI_CONTROL_CHANGE, 74, 64}) && accepted < 10000) {
+            ++accepted;
+        }
+        REQUIRE(accepted > 0);
+        REQUIRE(accepted < 10000);
+
+        // One block drains everything
+        synth.processStereo(left.data(), right.data(), 256);
+        REQUIRE(synth.postEvent({0, MIDI_CONTROL_CHANGE, 74, 64}));
+    }
+}
+
+TEST_CASE("Synth sample-accurate event timing", "[synth]") {
+    const uint64_t blockStart = 1000000000ULL;  // Arbitrary event-clock time
+    // Nanoseconds for a frame offset at 48 kHz (half a frame in, to avoid rounding edges)
+    auto frameTime = [blockStart](int frame) {
+        return blockStart + static_cast<uint64_t>((frame + 0.5) * 1e9 / 48000.0);
+    };
+
+    ChorusParams chorusParams;
+    chorusParams.mode = Chorus::OFF;  // Dry output, so the onset is visible directly
+
+    std::vector<Sample> left(256), right(256);
+    std::vector<Sample> refLeft(256), refRight(256);
+
+    SECTION("A note-on lands on its frame offset") {
+        Synth timed;
+        Synth reference;
+        timed.setChorusParameters(chorusParams);
+        reference.setChorusParameters(chorusParams);
+
+        timed.setBlockTimestamp(blockStart);
+        REQUIRE(timed.postEvent({frameTime(100), MIDI_NOTE_ON, 60, 127}));
+        timed.processStereo(left.data(), right.data(), 256);
+
+        // Reference: the same note triggered by hand after 100 samples
+        reference.processStereo(refLeft.data(), refRight.data(), 100);
+        reference.handleNoteOn(60, 1.0f);
+        reference.processStereo(refLeft.data() + 100, refRight.data() + 100, 156);
+
+        for (int i = 0; i < 100; ++i) {
+            REQUIRE(left[i] == 0.0f);
+        }
+        REQUIRE(left == refLeft);
+        REQUIRE(right == refRight);
+    }
+
+    SECTION("Events beyond the block wait for the next call") {
+        Synth synth;
+        synth.setChorusParameters(chorusParams);
+        synth.setBlockTimestamp(blockStart);
+        REQUIRE(synth.postEvent({frameTime(300), MIDI_NOTE_ON, 60, 127}));
+
+        synth.processStereo(left.data(), right.data(), 256);
+        for (Sample s : left) {
+            REQUIRE(s == 0.0f);
+        }
+
+        // The clock advances by itself: the note starts 44 samples into the next call
+        synth.processStereo(left.data(), right.data(), 256);
+        for (int i = 0; i < 44; ++i) {
+            REQUIRE(left[i] == 0.0f);
+        }
+        float peak = 0.0f;
+        for (int i = 44; i < 256; ++i) {
+            peak = std::max(peak, std::abs(left[i]));
+        }
+        REQUIRE(peak > 0.0f);
+    }
+
+    SECTION("Late events apply at the first sample") {
+        Synth timed;
+        Synth reference;
+        timed.setChorusParameters(chorusParams);
+        reference.setChorusParameters(chorusParams);
+
+        timed.setBlockTimestamp(blockStart);
+        REQUIRE(timed.postEvent({blockStart - 5000000, MIDI_NOTE_ON, 60, 127}));
+        timed.processStereo(left.data(), right.data(), 256);
+
+        reference.handleNoteOn(60, 1.0f);
+        reference.processStereo(refLeft.data(), refRight.data(), 256);
+        REQUIRE(left == refLeft);
+    }
+}
+
+TEST_CASE("Synth patches", "[synth]") {
+    Patch patch;
+    patch.dco.sawLevel = 0.3f;
+    patch.dco.pulseLevel = 0.7f;
+    patch.dco.enableDrift = false;
+    patch.filter.cutoff = 0.4f;
+    patch.filter.resonance = 0.6f;
+    patch.ampEnv.attack = 0.002f;
+    patch.lfo.rate = 5.0f;
+    patch.chorus.mode = 1;
+    patch.performance.vcaLevel = 0.6f;
+
+    auto render = [](Synth& synth, int numSamples) {
+        std::vector<Sample> left(numSamples);
+        std::vector<Sample> right(numSamples);
+        synth.processStereo(left.data(), right.data(), numSamples);
+        return left;
+    };
+
+    SECTION("A patch sounds the same as the struct setters") {
+        Synth a, b;
+        a.setPatch(patch);
+        b.setDcoParameters(patch.dco);
+        b.setFilterParameters(patch.filter);
+        b.setFilterEnvParameters(patch.filterEnv);
+        b.setAmpEnvParameters(patch.ampEnv);
+        b.setLfoParameters(patch.lfo);
+        b.setChorusParameters(patch.chorus);
+        b.setPerformanceParameters(patch.performance);
+        for (Synth* synth : {&a, &b}) {
+            synth->setSeed(2);
+            synth->handleNoteOn(60, 1.0f);
+        }
+        REQUIRE(render(a, 2048) == render(b, 2048));
+    }
+
+    SECTION("A posted patch applies whole at the next render call") {
+        Synth posted, direct;
+        for (Synth* synth : {&posted, &direct}) {
+            synth->setSeed(2);
+            synth->handleNoteOn(60, 1.0f);
+        }
+        render(posted, 256);
+        render(direct, 256);
+
+        posted.postPatch(patch);
+        REQUIRE(posted.getPatch().filter.cutoff != patch.filter.cutoff);  // Not yet
+        direct.setPatch(patch);
+        REQUIRE(render(posted, 1024) == render(direct, 1024));
+        REQUIRE(posted.getPatch().filter.cutoff == patch.filter.cutoff);
+    }
+
+    SECTION("A pending patch wakes an idle engine") {
+        Synth synth;
+        REQUIRE(synth.isIdle());
+        synth.postPatch(patch);
+        REQUIRE_FALSE(synth.isIdle());
+        render(synth, 64);
+        REQUIRE(synth.isIdle());
+        REQUIRE(synth.getPatch().chorus.mode == 1);
+    }
+
+    SECTION("Controllers keep their positions") {
+        Synth synth;
+        synth.handlePitchBend(0.5f);
+        synth.handleModWheel(0.25f);
+        synth.handleSustainPedal(true);
+        synth.setPatch(patch);
+        Patch current = synth.getPatch();
+        REQUIRE(current.performance.pitchBend == 0.5f);
+        REQUIRE(current.performance.modWheel == 0.25f);
+        REQUIRE(current.performance.sustainPedal);
+        REQUIRE(current.performance.vcaLevel == 0.6f);
+    }
+
+    SECTION("Snapshots report ramp targets, and a patch replaces ramps") {
+        Synth synth;
+        synth.setParamValue(ParamId::FILTER_CUTOFF, 0.1f);
+        REQUIRE(synth.getPatch().filter.cutoff == 0.1f);
+        synth.setPatch(patch);
+        render(synth, 1024);
+        REQUIRE(synth.getPatch().filter.cutoff == patch.filter.cutoff);
+    }
+}
+
+TEST_CASE("Synth program changes", "[synth]") {
+    Patch patch;
+    patch.dco.sawLevel = 0.0f;
+    patch.dco.pulseLevel = 1.0f;
+    patch.dco.enableDrift = false;
+    patch.filter.cutoff = 0.3f;
+    patch.chorus.mode = 0;
+
+    PatchRecord records[2];
+    encodePatch(Patch(), "Init", records[0]);
+    encodePatch(patch, "Pulse", records[1]);
+    auto lookup = [](int program, void* userData) -> const PatchRecord* {
+        return program < 2 ? &static_cast<const PatchRecord*>(userData)[program] : nullptr;
+    };
+
+    const uint64_t blockStart = 1000000000ULL;
+    auto frameTime = [blockStart](int frame) {
+        return blockStart + static_cast<uint64_t>((frame + 0.5) * 1e9 / 48000.0);
+    };
+
+    std::vector<Sample> left(256), right(256);
+    std::vector<Sample> refLeft(256), refRight(256);
+
+    SECTION("A queued Program Change applies at its frame offset, after earlier notes") {
+        Synth timed, reference;
+        timed.setProgramLookup(lookup, records);
+        for (Synth* synth : {&timed, &reference}) {
+            synth->setSeed(4);
+        }
+
+        timed.setBlockTimestamp(blockStart);
+        REQUIRE(timed.postEvent({frameTime(0), MIDI_NOTE_ON, 60, 127}));
+        REQUIRE(timed.postEvent({frameTime(100), MIDI_PROGRAM_CHANGE, 1, 0}));
+        timed.processStereo(left.data(), right.data(), 256);
+
+        // Reference: the note starts on the old patch, the new one follows at 100
+        reference.handleNoteOn(60, 1.0f);
+        reference.processStereo(refLeft.data(), refRight.data(), 100);
+        reference.setPatch(decodePatch(records[1]));
+        reference.processStereo(refLeft.data() + 100, refRight.data() + 100, 156);
+
+        REQUIRE(left == refLeft);
+        REQUIRE(right == refRight);
+        REQUIRE(timed.getPatch().filter.cutoff == patch.filter.cutoff);
+    }
+
+    SECTION("Programs without a record are ignored") {
+        Synth synth;
+        synth.handleMidiEvent({0, MIDI_PROGRAM_CHANGE, 1, 0});  // No lookup set
+        REQUIRE(synth.getPatch().filter.cutoff == Patch().filter.cutoff);
+
+        synth.setProgramLookup(lookup, records);
+        synth.handleMidiEvent({0, MIDI_PROGRAM_CHANGE, 5, 0});
+        REQUIRE(synth.getPatch().filter.cutoff == Patch().filter.cutoff);
+        synth.handleMidiEvent({0, MIDI_PROGRAM_CHANGE, 1, 0});
+        REQUIRE(synth.getPatch().filter.cutoff == patch.filter.cutoff);
+    }
+}
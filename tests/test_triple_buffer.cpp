@@ -0,0 +1,111 @@
+/**
+ * Unit tests for TripleBuffer (control thread -> audio thread patch handoff)
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include "triple_buffer.h"
+
+using namespace phj;
+
+namespace {
+
+// Every field carries the same sequence number, so a torn read shows up
+struct Snapshot {
+    uint32_t values[64];
+
+    void fill(uint32_t value) {
+        for (uint32_t& v : values) {
+            v = value;
+        }
+    }
+
+    bool consistent() const {
+        for (uint32_t v : values) {
+            if (v != values[0]) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+} // namespace
+
+TEST_CASE("TripleBuffer basic operation", "[triple_buffer]") {
+    TripleBuffer<int> buffer;
+
+    SECTION("Nothing to read until something is published") {
+        REQUIRE_FALSE(buffer.pending());
+        REQUIRE_FALSE(buffer.update());
+    }
+
+    SECTION("The reader gets the latest value once") {
+        buffer.publish(1);
+        buffer.publish(2);
+        REQUIRE(buffer.pending());
+        REQUIRE(buffer.update());
+        REQUIRE(buffer.read() == 2);
+        REQUIRE_FALSE(buffer.pending());
+        REQUIRE_FALSE(buffer.update());
+        REQUIRE(buffer.read() == 2);  // Kept until the next update
+    }
+
+    SECTION("Writing in place") {
+        buffer.write() = 7;
+        REQUIRE_FALSE(buffer.pending());
+        buffer.publish();
+        REQUIRE(buffer.update());
+        REQUIRE(buffer.read() == 7);
+    }
+
+    SECTION("The reader's slot is not touched by later writes") {
+        buffer.publish(1);
+        REQUIRE(buffer.update());
+        const int* held = &buffer.read();
+        for (int i = 2; i < 10; ++i) {
+            buffer.publish(i);
+        }
+        REQUIRE(*held == 1);
+        REQUIRE(buffer.update());
+        REQUIRE(buffer.read() == 9);
+    }
+}
+
+TEST_CASE("TripleBuffer across threads", "[triple_buffer]") {
+    // The writer publishes snapshots as fast as it can while the reader
+    // picks them up; every snapshot read must be whole and never older than
+    // the previous one
+    constexpr uint32_t NUM_SNAPSHOTS = 100000;
+    TripleBuffer<Snapshot> buffer;
+    std::atomic<bool> done(false);
+
+    std::thread writer([&buffer, &done]() {
+        for (uint32_t i = 1; i <= NUM_SNAPSHOTS; ++i) {
+            buffer.write().fill(i);
+            buffer.publish();
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    uint32_t last = 0;
+    bool intact = true;
+    bool ordered = true;
+    while (!done.load(std::memory_order_acquire) || buffer.pending()) {
+        if (!buffer.update()) {
+            std::this_thread::yield();
+            continue;
+        }
+        const Snapshot& snapshot = buffer.read();
+        intact = intact && snapshot.consistent();
+        ordered = ordered && snapshot.values[0] > last;
+        last = snapshot.values[0];
+    }
+    writer.join();
+
+    REQUIRE(intact);
+    REQUIRE(ordered);
+    REQUIRE(last == NUM_SNAPSHOTS);
+}
@@ -398,6 +398,70 @@ TEST_CASE("Voice pitch bend (M11)", "[voice][m11]") {
     }
 }
 
+TEST_CASE("Voice pitch offsets are cached", "[voice][m11]") {
+    Voice voice;
+    voice.setSampleRate(48000.0f);
+
+    DcoParams dcoParams;
+    dcoParams.sawLevel = 1.0f;
+    dcoParams.enableDrift = false;
+
+    FilterParams filterParams;
+    filterParams.cutoff = 0.8f;
+
+    EnvelopeParams envParams;
+    envParams.attack = 0.001f;
+    envParams.decay = 0.1f;
+    envParams.sustain = 1.0f;
+    envParams.release = 0.05f;
+
+    voice.setParameters(dcoParams, filterParams, envParams, envParams);
+
+    // Rising zero crossings over one second = frequency in Hz
+    auto measureFrequency = [&voice]() {
+        std::vector<Sample> samples(48000);
+        voice.process(samples.data(), 48000);
+        int crossings = 0;
+        for (size_t i = 1; i < samples.size(); ++i) {
+            if (samples[i - 1] < 0.0f && samples[i] >= 0.0f) {
+                ++crossings;
+            }
+        }
+        return crossings;
+    };
+
+    SECTION("Bend and tune set between notes apply to the next note") {
+        voice.setPitchBend(1.0f, 2.0f);   // +2 semitones
+        voice.setMasterTune(50.0f);       // +50 cents
+        voice.noteOn(57, 1.0f);           // A3 + 2.5 semitones
+
+        float expected = 220.0f * std::pow(2.0f, 2.5f / 12.0f);
+        REQUIRE(std::abs(measureFrequency() - expected) <= 2.0f);
+    }
+
+    SECTION("Bend changes during a note take effect") {
+        voice.noteOn(57, 1.0f);
+        REQUIRE(std::abs(measureFrequency() - 220.0f) <= 2.0f);
+
+        voice.setPitchBend(-1.0f, 12.0f);  // Octave down
+        REQUIRE(std::abs(measureFrequency() - 110.0f) <= 2.0f);
+    }
+
+    SECTION("Portamento arrives exactly on the target pitch") {
+        voice.setPortamentoTime(0.05f);
+        voice.noteOn(57, 1.0f);
+        for (int i = 0; i < 1000; ++i) {
+            voice.process();
+        }
+
+        voice.noteOn(69, 1.0f);
+        for (int i = 0; i < 4800; ++i) {
+            voice.process();
+        }
+        REQUIRE(std::abs(measureFrequency() - 440.0f) <= 2.0f);
+    }
+}
+
 TEST_CASE("Voice VCA mode (M13)", "[voice][m13]") {
     Voice voice;
     voice.setSampleRate(48000.0f);
@@ -423,21 +487,23 @@ TEST_CASE("Voice VCA mode (M13)", "[voice][m13]") {
         voice.noteOn(60, 1.0f);
 
         // Early samples should be quiet (attack phase)
-        std::vector<Sample> earlySamples(100);
-        voice.process(earlySamples.data(), 100);
+        // Windows span more than one period of C4 so the peak does not
+        // depend on the random note-on phase
+        std::vector<Sample> earlySamples(200);
+        voice.process(earlySamples.data(), 200);
 
         float earlyMax = 0.0f;
         for (Sample s : earlySamples) {
             earlyMax = std::max(earlyMax, std::abs(s));
         }
 
-        // Process more (should be louder)
-        for (int i = 0; i < 5000; ++i) {
+        // Process more (should be louder, still before the attack peak)
+        for (int i = 0; i < 2000; ++i) {
             voice.process();
         }
 
-        std::vector<Sample> lateSamples(100);
-        voice.process(lateSamples.data(), 100);
+        std::vector<Sample> lateSamples(200);
+        voice.process(lateSamples.data(), 200);
 
         float lateMax = 0.0f;
         for (Sample s : lateSamples) {
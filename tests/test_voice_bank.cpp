@@ -0,0 +1,177 @@
+/**
+ * Unit tests for VoiceBank (lane-parallel voice rendering)
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <vector>
+#include "voice_bank.h"
+#include "filter.h"
+
+using namespace phj;
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("VoiceBank lane layout", "[voicebank]") {
+    SECTION("Lanes cover all voices in multiples of 4") {
+        REQUIRE(VoiceBank::NUM_LANES >= NUM_VOICES);
+        REQUIRE(VoiceBank::NUM_LANES % 4 == 0);
+    }
+}
+
+TEST_CASE("Filter split processing matches Filter::process", "[voicebank][filter]") {
+    FilterParams params;
+    params.cutoff = 0.4f;
+    params.resonance = 0.7f;
+    params.drive = 2.0f;
+    params.hpfMode = 2;
+
+    Filter reference;
+    Filter split;
+    reference.setParameters(params);
+    split.setParameters(params);
+
+    float s1 = 0.0f, s2 = 0.0f, s3 = 0.0f, s4 = 0.0f;
+    for (int i = 0; i < 2000; ++i) {
+        Sample input = std::sin(i * 0.05f) + ((i % 100) < 50 ? 0.5f : -0.5f);
+
+        Sample expected = reference.process(input);
+
+        Sample x = split.processInput(input);
+        Sample actual = Filter::ladderTick(x, split.getCutoffCoefficient(),
+                                           split.getResonanceCoefficient(),
+                                           s1, s2, s3, s4);
+
+        REQUIRE(actual == expected);
+    }
+}
+
+TEST_CASE("VoiceBank rendering", "[voicebank]") {
+    VoiceBank bank;
+    bank.setSampleRate(48000.0f);
+
+    DcoParams dcoParams;
+    dcoParams.sawLevel = 1.0f;
+    dcoParams.enableDrift = false;
+
+    FilterParams filterParams;
+    filterParams.cutoff = 0.8f;
+
+    EnvelopeParams envParams;
+    envParams.attack = 0.001f;
+    envParams.decay = 0.1f;
+    envParams.sustain = 0.8f;
+    envParams.release = 0.01f;
+
+    for (int i = 0; i < NUM_VOICES; ++i) {
+        bank[i].setParameters(dcoParams, filterParams, envParams, envParams);
+    }
+
+    std::vector<float> lfo(512, 0.0f);
+    std::vector<Sample> output(512);
+
+    SECTION("Idle bank renders silence") {
+        REQUIRE_FALSE(bank.anyActive());
+
+        bank.process(lfo.data(), nullptr, output.data(), 512);
+        for (Sample s : output) {
+            REQUIRE(s == 0.0f);
+        }
+    }
+
+    SECTION("Active voices are rendered and summed") {
+        bank.noteOn(0, 60, 1.0f);
+        bank.process(lfo.data(), nullptr, output.data(), 512);
+
+        float singlePeak = 0.0f;
+        for (Sample s : output) {
+            singlePeak = std::max(singlePeak, std::abs(s));
+        }
+        REQUIRE(singlePeak > 0.01f);
+
+        for (int i = 1; i < NUM_VOICES; ++i) {
+            bank.noteOn(i, 60 + i * 2, 1.0f);
+        }
+        bank.process(lfo.data(), nullptr, output.data(), 512);
+
+        float fullPeak = 0.0f;
+        for (Sample s : output) {
+            REQUIRE(std::isfinite(s));
+            fullPeak = std::max(fullPeak, std::abs(s));
+        }
+        REQUIRE(fullPeak > singlePeak);
+    }
+
+    SECTION("Bank goes idle after all voices release") {
+        bank.noteOn(2, 64, 1.0f);
+        bank.process(lfo.data(), nullptr, output.data(), 512);
+        bank[2].noteOff();
+
+        for (int block = 0; block < 100; ++block) {
+            bank.process(lfo.data(), nullptr, output.data(), 512);
+        }
+
+        REQUIRE_FALSE(bank.anyActive());
+        for (Sample s : output) {
+            REQUIRE(s == 0.0f);
+        }
+    }
+
+    SECTION("Odd block sizes are rendered completely") {
+        bank.noteOn(0, 48, 1.0f);
+
+        std::vector<Sample> odd(45, 99.0f);
+        bank.process(lfo.data(), nullptr, odd.data(), 45);
+
+        for (Sample s : odd) {
+            REQUIRE(std::abs(s) < 4.0f);
+        }
+    }
+}
+
+TEST_CASE("VoiceBank shared noise source", "[voicebank]") {
+    DcoParams dcoParams;
+    dcoParams.sawLevel = 0.0f;
+    dcoParams.noiseLevel = 1.0f;
+    dcoParams.enableDrift = false;
+
+    FilterParams filterParams;
+    filterParams.cutoff = 0.7f;
+
+    EnvelopeParams envParams;
+    envParams.attack = 0.001f;
+    envParams.sustain = 1.0f;
+
+    std::vector<float> lfo(256, 0.0f);
+    std::vector<Sample> noise(256);
+    Random rng(5);
+    for (Sample& n : noise) {
+        n = rng.nextBipolar();
+    }
+
+    auto render = [&](int numVoices) {
+        VoiceBank bank;
+        bank.setSampleRate(48000.0f);
+        for (int i = 0; i < NUM_VOICES; ++i) {
+            bank[i].setParameters(dcoParams, filterParams, envParams, envParams);
+        }
+        for (int i = 0; i < numVoices; ++i) {
+            bank.noteOn(i, 60 + i * 7, 1.0f);
+        }
+        std::vector<Sample> output(256);
+        bank.process(lfo.data(), noise.data(), output.data(), 256);
+        return output;
+    };
+
+    // Every voice reads the same noise block, so with noise as the only
+    // source (and no key tracking) two voices render exactly twice one voice
+    std::vector<Sample> single = render(1);
+    std::vector<Sample> pair = render(2);
+
+    float peak = 0.0f;
+    for (size_t i = 0; i < single.size(); ++i) {
+        peak = std::max(peak, std::abs(single[i]));
+        REQUIRE_THAT(pair[i], WithinAbs(2.0f * single[i], 1e-6f));
+    }
+    REQUIRE(peak > 0.01f);
+}